@@ -55,6 +55,7 @@ osThreadId defaultTaskHandle;
 /* USER CODE BEGIN FunctionPrototypes */
 extern void XYControlTask(void const *argument);
 extern void TimingThread(void const *argument);
+extern void TimingThreadInit(void);
 
 /* USER CODE END FunctionPrototypes */
 
@@ -102,6 +103,7 @@ void MX_FREERTOS_Init(void) {
 
   /* USER CODE BEGIN RTOS_QUEUES */
   /* add queues, ... */
+  TimingThreadInit();
   /* USER CODE END RTOS_QUEUES */
 
   /* Create the thread(s) */
@@ -27,6 +27,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "Clock.h"
 #include "oled.h"
 /* USER CODE END Includes */
 
@@ -96,6 +97,8 @@ int main(void)
   MX_USART1_UART_Init();
   MX_I2C2_Init();
   /* USER CODE BEGIN 2 */
+  // 微秒时钟, 之后的中断和线程都可能读取
+  ClockInit();
   // A board ouput 24VDC
   HAL_GPIO_WritePin(GPIOH, GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5, GPIO_PIN_SET);
   // OLED init
@@ -188,7 +191,10 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM7)
+  {
+    ClockMicros();  // 每毫秒读取一次, 保证不漏掉DWT计数器的回绕
+  }
   /* USER CODE END Callback 1 */
 }
 
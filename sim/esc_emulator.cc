@@ -0,0 +1,215 @@
+/**
+ * @file esc_emulator.cc
+ * @brief 两路M2006/C610电调仿真(SocketCAN)
+ *
+ * @note
+ * 接收0x200电流指令, 以1kHz发送0x201/0x202反馈帧(角度 转速 转矩电流 温度),
+ * 内部用一阶电机模型加丝杆行程限位近似兑矿槽的运动.
+ *
+ * 用法: esc_emulator [can接口, 默认vcan0]
+ */
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace
+{
+  // C610协议
+  const uint32_t kCommandId = 0x200;   // 电调1~4电流指令
+  const uint32_t kFeedbackId = 0x200;  // 反馈ID = 0x200 + 电调ID
+  const int16_t kMaxCurrent = 10000;   // 电流指令范围±10000 -> ±10A
+
+  // 电机模型(转子侧)
+  const double kSpeedGain = 2.0;      // 稳态转速/电流指令 (rpm per unit)
+  const double kTimeConstant = 0.05;  // 机电时间常数(s)
+  const int16_t kStiction = 300;      // 静摩擦对应的电流死区
+  const double kGearRatio = 36.0;     // M2006减速比
+  const double kPeriod = 0.001;       // 反馈周期(s)
+
+  struct Axis
+  {
+    uint8_t id;            // 电调ID
+    double lead;           // 丝杆导程(mm)
+    double limit;          // 机械行程(±mm)
+    int16_t current;       // 当前电流指令
+    double rpm;            // 转子转速
+    double angle;          // 转子角度(0~8191)
+    double pos;            // 丝杆位置(mm)
+    uint32_t last_cmd_ms;  // 最近一次收到指令的时间
+  };
+
+  volatile sig_atomic_t running = 1;
+
+  void OnSignal(int) { running = 0; }
+
+  uint32_t NowMs()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint32_t>(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+  }
+
+  int OpenCan(const char *iface)
+  {
+    int fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) return -1;
+
+    ifreq ifr{};
+    strncpy(ifr.ifr_name, iface, IFNAMSIZ - 1);
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) < 0)
+    {
+      close(fd);
+      return -1;
+    }
+
+    sockaddr_can addr{};
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+    {
+      close(fd);
+      return -1;
+    }
+
+    // 只接收电流指令帧
+    can_filter filter{};
+    filter.can_id = kCommandId;
+    filter.can_mask = CAN_SFF_MASK;
+    setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter));
+    return fd;
+  }
+
+  void HandleCommand(const can_frame &frame, Axis *axes, int count, uint32_t now)
+  {
+    if (frame.can_id != kCommandId) return;
+    for (int i = 0; i < count; i++)
+    {
+      int index = (axes[i].id - 1) * 2;
+      if (index + 1 >= frame.can_dlc) continue;
+      int16_t current = static_cast<int16_t>((frame.data[index] << 8) | frame.data[index + 1]);
+      if (current > kMaxCurrent) current = kMaxCurrent;
+      if (current < -kMaxCurrent) current = -kMaxCurrent;
+      axes[i].current = current;
+      axes[i].last_cmd_ms = now;
+    }
+  }
+
+  void Step(Axis &axis, uint32_t now)
+  {
+    // 指令超时(>100ms)视为掉线, 电调停止输出
+    int16_t current = (now - axis.last_cmd_ms > 100) ? 0 : axis.current;
+
+    double target = (std::abs(current) < kStiction && std::fabs(axis.rpm) < 1.0) ? 0 : kSpeedGain * current;
+    axis.rpm += (target - axis.rpm) * kPeriod / kTimeConstant;
+
+    // 到达机械限位时被挡住
+    double next = axis.pos + axis.rpm / 60.0 * kPeriod / kGearRatio * axis.lead;
+    if (next > axis.limit || next < -axis.limit)
+    {
+      axis.rpm = 0;
+      return;
+    }
+    axis.pos = next;
+
+    axis.angle += axis.rpm / 60.0 * kPeriod * 8192.0;
+    axis.angle = std::fmod(axis.angle, 8192.0);
+    if (axis.angle < 0) axis.angle += 8192.0;
+  }
+
+  void SendFeedback(int fd, const Axis &axis)
+  {
+    can_frame frame{};
+    uint16_t angle = static_cast<uint16_t>(axis.angle) & 0x1FFF;
+    int16_t rpm = static_cast<int16_t>(std::lround(axis.rpm));
+
+    frame.can_id = kFeedbackId + axis.id;
+    frame.can_dlc = 8;
+    frame.data[0] = angle >> 8;
+    frame.data[1] = angle & 0xFF;
+    frame.data[2] = static_cast<uint16_t>(rpm) >> 8;
+    frame.data[3] = static_cast<uint16_t>(rpm) & 0xFF;
+    frame.data[4] = static_cast<uint16_t>(axis.current) >> 8;
+    frame.data[5] = static_cast<uint16_t>(axis.current) & 0xFF;
+    frame.data[6] = 30;  // 温度
+    frame.data[7] = 0;
+    if (write(fd, &frame, sizeof(frame)) < 0 && errno != ENOBUFS)
+    {
+      perror("write");
+    }
+  }
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  const char *iface = argc > 1 ? argv[1] : "vcan0";
+
+  int fd = OpenCan(iface);
+  if (fd < 0)
+  {
+    fprintf(stderr, "esc_emulator: cannot open %s: %s\n", iface, strerror(errno));
+    return 1;
+  }
+
+  signal(SIGINT, OnSignal);
+  signal(SIGTERM, OnSignal);
+
+  // X轴导程14mm 行程±330mm, Y轴导程8mm 行程±200mm, 起始于中点
+  Axis axes[] = {
+      {1, 14.0, 330.0, 0, 0, 0, 0, 0},
+      {2, 8.0, 200.0, 0, 0, 0, 0, 0},
+  };
+  const int count = sizeof(axes) / sizeof(axes[0]);
+
+  fprintf(stderr, "esc_emulator: %d ESCs on %s\n", count, iface);
+
+  timespec next;
+  clock_gettime(CLOCK_MONOTONIC, &next);
+  uint32_t last_report = NowMs();
+
+  while (running)
+  {
+    // 非阻塞读取全部待处理指令
+    can_frame frame;
+    uint32_t now = NowMs();
+    while (recv(fd, &frame, sizeof(frame), MSG_DONTWAIT) == sizeof(frame))
+    {
+      HandleCommand(frame, axes, count, now);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+      Step(axes[i], now);
+      SendFeedback(fd, axes[i]);
+    }
+
+    if (now - last_report >= 1000)
+    {
+      last_report = now;
+      fprintf(stderr, "x: %8.2fmm %7.0frpm  y: %8.2fmm %7.0frpm\n", axes[0].pos, axes[0].rpm, axes[1].pos,
+              axes[1].rpm);
+    }
+
+    // 1kHz绝对定时
+    next.tv_nsec += 1000000;
+    if (next.tv_nsec >= 1000000000)
+    {
+      next.tv_nsec -= 1000000000;
+      next.tv_sec++;
+    }
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+  }
+
+  close(fd);
+  return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file font_bench.cc
+ * @brief 中文字库查找耗时对比: 顺序memcmp查找与编译期索引二分查找
+ *
+ * @note
+ * 编译期生成一个500字的16x16字库(编码乱序), 分别用无索引和有索引的Font
+ * 查找每个字以及一个不在字库中的字, 打印每次查找的平均耗时.
+ *
+ * 用法: font_bench [轮数, 默认2000]
+ */
+#include <time.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "font_index.h"
+
+namespace
+{
+  const uint16_t kGlyphs = 500;
+  const uint8_t kGlyphSize = 36;  // 4字节编码 + 16x16字模
+
+  struct BenchTable
+  {
+    uint8_t chars[kGlyphs][kGlyphSize];
+  };
+
+  // 第i个字的Unicode码点, 取自CJK统一汉字区并打乱顺序
+  constexpr uint32_t CodePoint(uint16_t i) { return 0x4E00 + (i * 263u) % 4096; }
+
+  constexpr void EncodeUtf8(uint32_t cp, uint8_t *out)
+  {
+    out[0] = static_cast<uint8_t>(0xE0 | (cp >> 12));
+    out[1] = static_cast<uint8_t>(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = static_cast<uint8_t>(0x80 | (cp & 0x3F));
+    out[3] = 0;
+  }
+
+  constexpr BenchTable MakeTable()
+  {
+    BenchTable table{};
+    for (uint16_t i = 0; i < kGlyphs; i++)
+    {
+      EncodeUtf8(CodePoint(i), table.chars[i]);
+      for (uint8_t j = 4; j < kGlyphSize; j++)
+      {
+        table.chars[i][j] = static_cast<uint8_t>(i + j);
+      }
+    }
+    return table;
+  }
+
+  constexpr BenchTable kTable = MakeTable();
+  constexpr auto kIndex = MakeFontIndex<kGlyphs>(kTable.chars);
+
+  uint64_t NowNs()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+
+  // 依次查找所有字和一个缺字, 返回每次查找的平均耗时(ns)
+  double Run(const Font *font, const char (*queries)[4], int count, int rounds, bool *ok)
+  {
+    uintptr_t sink = 0;
+    uint64_t start = NowNs();
+    for (int r = 0; r < rounds; r++)
+    {
+      for (int i = 0; i < count; i++)
+      {
+        sink += reinterpret_cast<uintptr_t>(FontFindGlyph(font, queries[i], 3));
+      }
+    }
+    uint64_t elapsed = NowNs() - start;
+
+    // 校验查找结果
+    *ok = true;
+    for (int i = 0; i < kGlyphs; i++)
+    {
+      *ok &= FontFindGlyph(font, queries[i], 3) == kTable.chars[i];
+    }
+    *ok &= FontFindGlyph(font, queries[kGlyphs], 3) == nullptr;
+
+    volatile uintptr_t keep = sink;
+    (void)keep;
+    return static_cast<double>(elapsed) / (static_cast<double>(rounds) * count);
+  }
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  int rounds = argc > 1 ? atoi(argv[1]) : 2000;
+  if (rounds <= 0) rounds = 2000;
+
+  // 查询: 字库中全部500个字, 加上一个不在字库中的字
+  static char queries[kGlyphs + 1][4];
+  for (int i = 0; i < kGlyphs; i++)
+  {
+    memcpy(queries[i], kTable.chars[i], 4);
+  }
+  EncodeUtf8(0x9FA5, reinterpret_cast<uint8_t *>(queries[kGlyphs]));
+
+  const Font linear = {16, 16, &kTable.chars[0][0], kGlyphs, &afont16x8, NULL};
+  const Font indexed = {16, 16, &kTable.chars[0][0], kGlyphs, &afont16x8, kIndex.data()};
+
+  bool linear_ok, indexed_ok;
+  double linear_ns = Run(&linear, queries, kGlyphs + 1, rounds, &linear_ok);
+  double indexed_ns = Run(&indexed, queries, kGlyphs + 1, rounds, &indexed_ok);
+
+  printf("%u glyphs, %d lookups per method\n", kGlyphs, rounds * (kGlyphs + 1));
+  printf("linear  %8.1f ns/lookup  %s\n", linear_ns, linear_ok ? "ok" : "MISMATCH");
+  printf("indexed %8.1f ns/lookup  %s\n", indexed_ns, indexed_ok ? "ok" : "MISMATCH");
+  printf("speedup %8.1fx\n", linear_ns / indexed_ns);
+  return linear_ok && indexed_ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file format_bench.cc
+ * @brief 数字格式化耗时对比: snprintf与Format.h
+ *
+ * @note
+ * 分别格式化无符号整数(胜利点, "%lu"), 右对齐整数("%5lu")和毫秒转秒的两位小数("%lu.%02lu"),
+ * 逐个校验两种实现的输出一致, 打印每次格式化的平均耗时.
+ *
+ * 用法: format_bench [轮数, 默认200]
+ */
+#include <time.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Format.h"
+
+namespace
+{
+  const int kValues = 10000;
+
+  // 编译期求值: 可直接用于常量初始化
+  constexpr bool ConstexprCheck()
+  {
+    char buf[8] = {};
+    FormatFixed(buf, sizeof(buf), -1234, 2);
+    return buf[0] == '-' && buf[1] == '1' && buf[3] == '.' && buf[5] == '4' && buf[6] == '\0';
+  }
+  static_assert(ConstexprCheck(), "Format.h must be usable in constant expressions");
+
+  // 小数位数超过上限时按上限处理, 不越界(越界在编译期求值时报错)
+  constexpr bool DecimalsClampCheck()
+  {
+    char buf[16] = {};
+    size_t len = FormatFixed(buf, sizeof(buf), 1, 14);
+    const char expected[] = "0.000000001";
+    for (size_t i = 0; i < sizeof(expected); i++)
+    {
+      if (buf[i] != expected[i]) return false;
+    }
+    return len == sizeof(expected) - 1;
+  }
+  static_assert(DecimalsClampCheck(), "FormatFixed must clamp decimals");
+
+  uint64_t NowNs()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+
+  // 第i个测试值, 覆盖1~10位数
+  uint32_t Value(int i) { return static_cast<uint32_t>(i) * 429467u >> (i % 28); }
+
+  void PrintfUInt(char *buf, size_t size, uint32_t v) { snprintf(buf, size, "%lu", static_cast<unsigned long>(v)); }
+  void FormatUIntCase(char *buf, size_t size, uint32_t v) { FormatUInt(buf, size, v); }
+
+  void PrintfPadded(char *buf, size_t size, uint32_t v)
+  {
+    snprintf(buf, size, "%5lu", static_cast<unsigned long>(v % 100000));
+  }
+  void FormatPaddedCase(char *buf, size_t size, uint32_t v) { FormatUInt(buf, size, v % 100000, 5); }
+
+  void PrintfSeconds(char *buf, size_t size, uint32_t v)
+  {
+    snprintf(buf, size, "%lu.%02lu", static_cast<unsigned long>(v / 1000), static_cast<unsigned long>(v % 1000 / 10));
+  }
+  void FormatSecondsCase(char *buf, size_t size, uint32_t v) { FormatSeconds(buf, size, v, 2); }
+
+  // 返回每次格式化的平均耗时(ns)
+  double Run(void (*format)(char *, size_t, uint32_t), int rounds)
+  {
+    char buf[16];
+    uint32_t sink = 0;
+    uint64_t start = NowNs();
+    for (int r = 0; r < rounds; r++)
+    {
+      for (int i = 0; i < kValues; i++)
+      {
+        format(buf, sizeof(buf), Value(i));
+        sink += static_cast<uint8_t>(buf[0]);
+      }
+    }
+    uint64_t elapsed = NowNs() - start;
+    volatile uint32_t keep = sink;
+    (void)keep;
+    return static_cast<double>(elapsed) / (static_cast<double>(rounds) * kValues);
+  }
+
+  bool Check(void (*reference)(char *, size_t, uint32_t), void (*format)(char *, size_t, uint32_t))
+  {
+    for (int i = 0; i < kValues; i++)
+    {
+      char expected[16], actual[16];
+      reference(expected, sizeof(expected), Value(i));
+      format(actual, sizeof(actual), Value(i));
+      if (strcmp(expected, actual) != 0)
+      {
+        printf("mismatch at %lu: \"%s\" != \"%s\"\n", static_cast<unsigned long>(Value(i)), actual, expected);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  struct Case
+  {
+    const char *name;
+    void (*reference)(char *, size_t, uint32_t);
+    void (*format)(char *, size_t, uint32_t);
+  };
+
+  const Case kCases[] = {
+      {"%lu", PrintfUInt, FormatUIntCase},
+      {"%5lu", PrintfPadded, FormatPaddedCase},
+      {"%lu.%02lu", PrintfSeconds, FormatSecondsCase},
+  };
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  int rounds = argc > 1 ? atoi(argv[1]) : 200;
+  if (rounds <= 0) rounds = 200;
+
+  bool all_ok = true;
+  printf("%d values per case\n", rounds * kValues);
+  for (const Case &c : kCases)
+  {
+    bool ok = Check(c.reference, c.format);
+    double printf_ns = Run(c.reference, rounds);
+    double format_ns = Run(c.format, rounds);
+    printf("%-10s snprintf %6.1f ns  Format %6.1f ns  speedup %4.1fx  %s\n", c.name, printf_ns, format_ns,
+           printf_ns / format_ns, ok ? "ok" : "MISMATCH");
+    all_ok &= ok;
+  }
+  return all_ok ? 0 : 1;
+}
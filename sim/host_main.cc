@@ -0,0 +1,220 @@
+/**
+ * @file host_main.cc
+ * @brief 主机仿真入口, 以与freertos.c相同的方式启动控制线程和计时线程
+ *
+ * @note
+ * 在vcan0上配合esc_emulator运行真实的XYControlTask,
+ * 每5秒打印各线程的周期执行时间、OLED的I2C流量和指令到运动延迟; 发送SIGUSR1模拟按下微动开关1.5s
+ *
+ * 遥控器: 从标准输入读取"左拨杆 右拨杆 [left_x left_y dial]", 拨杆为u/m/d,
+ * 例如"m u"或"d d 0 0 660", 之后以14ms周期向RemoteReceiver发送编码后的DR16帧; 输入"x"停止发送以模拟失联,
+ * 输入"i [n]"使之后n次OLED的I2C传输出错(默认1次)以验证总线恢复, 输入"s [文件]"把仿真屏幕的当前画面写为PBM(默认oled.pbm)
+ */
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <thread>
+
+#include "DisplayScheduler.h"
+#include "LatencyProbe.h"
+#include "RemoteReceiver.h"
+#include "TimingThread.h"
+#include "XYControlTask.h"
+#include "i2c.h"
+#include "oled.h"
+#include "sim.h"
+
+namespace
+{
+  volatile sig_atomic_t button_request = 0;
+
+  void OnButton(int) { button_request = 1; }
+
+  void RunXYControlTask()
+  {
+    SimRegisterThread("XYControlTask");
+    XYControlTask(nullptr);
+  }
+
+  void RunTimingThread()
+  {
+    SimRegisterThread("TimingThread");
+    TimingThread(nullptr);
+  }
+
+  // 遥控器输入, 各通道为-660~660, 拨杆为DR16编码(1上 3中 2下)
+  struct RemoteInput
+  {
+    int16_t left_x, left_y, dial;
+    uint8_t switch_l, switch_r;
+  };
+
+  std::atomic<bool> remote_active{false};
+  std::atomic<uint64_t> remote_input{0};
+
+  uint64_t PackInput(const RemoteInput &in)
+  {
+    return static_cast<uint16_t>(in.left_x) | static_cast<uint64_t>(static_cast<uint16_t>(in.left_y)) << 16 |
+           static_cast<uint64_t>(static_cast<uint16_t>(in.dial)) << 32 | static_cast<uint64_t>(in.switch_l) << 48 |
+           static_cast<uint64_t>(in.switch_r) << 56;
+  }
+
+  RemoteInput UnpackInput(uint64_t v)
+  {
+    return RemoteInput{static_cast<int16_t>(v), static_cast<int16_t>(v >> 16), static_cast<int16_t>(v >> 32),
+                       static_cast<uint8_t>(v >> 48), static_cast<uint8_t>(v >> 56)};
+  }
+
+  // 按DR16协议编码一帧
+  void EncodeFrame(const RemoteInput &in, uint8_t *frame)
+  {
+    uint16_t ch0 = REMOTE_CH_OFFSET;
+    uint16_t ch1 = REMOTE_CH_OFFSET;
+    uint16_t ch2 = REMOTE_CH_OFFSET + in.left_x;
+    uint16_t ch3 = REMOTE_CH_OFFSET + in.left_y;
+    uint16_t ch4 = REMOTE_CH_OFFSET + in.dial;
+
+    memset(frame, 0, REMOTE_FRAME_SIZE);
+    frame[0] = ch0 & 0xFF;
+    frame[1] = (ch0 >> 8) | (ch1 << 3);
+    frame[2] = (ch1 >> 5) | (ch2 << 6);
+    frame[3] = ch2 >> 2;
+    frame[4] = (ch2 >> 10) | (ch3 << 1);
+    frame[5] = (ch3 >> 7) | (in.switch_r << 4) | (in.switch_l << 6);
+    frame[16] = ch4 & 0xFF;
+    frame[17] = ch4 >> 8;
+  }
+
+  uint8_t ParseSwitch(char c)
+  {
+    switch (c)
+    {
+      case 'u':
+        return 1;
+      case 'd':
+        return 2;
+      default:
+        return 3;
+    }
+  }
+
+  int16_t ClampChannel(int value) { return value > 660 ? 660 : (value < -660 ? -660 : value); }
+
+  void RunRemoteInput()
+  {
+    char line[64];
+    while (fgets(line, sizeof(line), stdin))
+    {
+      if (line[0] == 'x')
+      {
+        remote_active.store(false);
+        continue;
+      }
+      if (line[0] == 'i')
+      {
+        int count = 1;
+        sscanf(line + 1, "%d", &count);
+        SimInjectI2cErrors(count > 0 ? count : 1);
+        continue;
+      }
+      if (line[0] == 's')
+      {
+        char path[48] = "oled.pbm";
+        sscanf(line + 1, "%47s", path);
+        fprintf(stderr, "[%7lu] snapshot %s %s\n", static_cast<unsigned long>(HAL_GetTick()), path,
+                SimOledWritePbm(path) ? "written" : "failed");
+        continue;
+      }
+
+      char sl, sr;
+      int lx = 0, ly = 0, dial = 0;
+      if (sscanf(line, " %c %c %d %d %d", &sl, &sr, &lx, &ly, &dial) < 2) continue;
+
+      RemoteInput in{ClampChannel(lx), ClampChannel(ly), ClampChannel(dial), ParseSwitch(sl), ParseSwitch(sr)};
+      remote_input.store(PackInput(in));
+      remote_active.store(true);
+    }
+  }
+
+  void RunRemoteTransmitter()
+  {
+    uint8_t frame[REMOTE_FRAME_SIZE];
+    while (true)
+    {
+      HAL_Delay(14);
+      if (!remote_active.load()) continue;
+      EncodeFrame(UnpackInput(remote_input.load()), frame);
+      remote_receiver.Feed(frame);
+    }
+  }
+}  // namespace
+
+int main()
+{
+  signal(SIGUSR1, OnButton);
+
+  latency_probe.SetEnabled(true);  // 仿真中默认开启延迟统计
+
+  OLED_Init();
+  TimingThreadInit();
+
+  std::thread xy_control(RunXYControlTask);
+  std::thread timing(RunTimingThread);
+  std::thread remote_input_reader(RunRemoteInput);
+  std::thread remote_transmitter(RunRemoteTransmitter);
+
+  uint32_t last_report = HAL_GetTick();
+  uint32_t last_i2c_bytes = hi2c2.tx_bytes;
+  while (true)
+  {
+    HAL_Delay(100);
+
+    if (button_request)
+    {
+      button_request = 0;
+      SimPressButton(1500);
+      fprintf(stderr, "[%7lu] button pressed\n", static_cast<unsigned long>(HAL_GetTick()));
+    }
+
+    if (HAL_GetTick() - last_report >= 5000)
+    {
+      last_report = HAL_GetTick();
+
+      SimLoopStats stats[SIM_MAX_THREADS];
+      int n = SimTakeLoopStats(stats, SIM_MAX_THREADS);
+      for (int i = 0; i < n; i++)
+      {
+        if (stats[i].cycles == 0) continue;
+        fprintf(stderr, "%-14s cycles %6llu  avg %6.1fus  max %6lluus  overruns %llu\n", stats[i].name,
+                static_cast<unsigned long long>(stats[i].cycles),
+                static_cast<double>(stats[i].busy_us_total) / stats[i].cycles,
+                static_cast<unsigned long long>(stats[i].busy_us_max),
+                static_cast<unsigned long long>(stats[i].overruns));
+      }
+
+      uint32_t i2c_bytes = hi2c2.tx_bytes;
+      OLED_Stats oled;
+      OLED_GetStats(&oled);
+      fprintf(stderr, "oled i2c       %8.1f bytes/s  errors %lu  timeouts %lu  recoveries %lu\n",
+              (i2c_bytes - last_i2c_bytes) / 5.0, static_cast<unsigned long>(oled.errors),
+              static_cast<unsigned long>(oled.timeouts), static_cast<unsigned long>(oled.recoveries));
+      last_i2c_bytes = i2c_bytes;
+      fprintf(stderr, "oled frames    %8lu  skipped busy %lu  skipped control %lu\n",
+              static_cast<unsigned long>(display_scheduler.frames()),
+              static_cast<unsigned long>(display_scheduler.skipped_busy()),
+              static_cast<unsigned long>(display_scheduler.skipped_control()));
+
+      const LatencyHistogram &total = latency_probe.histogram(LATENCY_INTERVAL_TOTAL);
+      if (total.count > 0)
+      {
+        fprintf(stderr, "latency        samples %5u  avg %6.1fms  max %6.1fms  timeouts %u\n", total.count,
+                static_cast<double>(total.sum_us) / total.count / 1000.0, total.max_us / 1000.0,
+                latency_probe.timeouts());
+      }
+    }
+  }
+
+  xy_control.join();
+  timing.join();
+  return 0;
+}
@@ -0,0 +1,271 @@
+/**
+ * @file oled_bench.cc
+ * @brief OLED绘制耗时对比
+ *
+ * @note
+ * 文本: 按XYControlTask中的位置(时间y=6, 胜利点y=24/42)用afont16x8反复绘制数字字符串,
+ * 分别用逐字节的参考实现和OLED_SetBlock绘制, 打印每个字符串的平均耗时.
+ * 填充图形: 进度条(120x6填充矩形)和倒计时圆(r=12), 对比逐像素的参考实现和按页掩码填充.
+ * 图元: 每个绘制函数、一帧完整的状态画面(标签+数值+发布)和曲线控件每个采样的单次耗时, 修改绘制代码前后对比.
+ *
+ * 用法: oled_bench [轮数, 默认20000]
+ */
+#include <time.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "OledWidget.h"
+#include "oled.h"
+
+// oled.cc中的逐字节写入函数, 未在oled.h中声明
+void OLED_SetBits(uint8_t x, uint8_t y, uint8_t data, OLED_ColorMode color);
+void OLED_SetBits_Fine(uint8_t x, uint8_t y, uint8_t data, uint8_t len, OLED_ColorMode color);
+
+namespace
+{
+  struct TextLine
+  {
+    uint8_t x;
+    uint8_t y;
+  };
+
+  // XYControlTask中的时间和胜利点位置
+  const TextLine kLines[] = {{60, 6}, {80, 24}, {90, 42}};
+
+  uint64_t NowNs()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+
+  // 逐字节写入的参考实现(原OLED_SetBlock)
+  void ReferenceSetBlock(uint8_t x, uint8_t y, const uint8_t *data, uint8_t w, uint8_t h, OLED_ColorMode color)
+  {
+    uint8_t fullRow = h / 8;
+    uint8_t partBit = h % 8;
+    for (uint8_t i = 0; i < w; i++)
+    {
+      for (uint8_t j = 0; j < fullRow; j++)
+      {
+        OLED_SetBits(x + i, y + j * 8, data[i + j * w], color);
+      }
+    }
+    if (partBit)
+    {
+      uint16_t fullNum = w * fullRow;
+      for (uint8_t i = 0; i < w; i++)
+      {
+        OLED_SetBits_Fine(x + i, y + (fullRow * 8), data[fullNum + i], partBit, color);
+      }
+    }
+  }
+
+  void ReferencePrint(uint8_t x, uint8_t y, const char *str, const ASCIIFont *font)
+  {
+    for (; *str; str++, x += font->w)
+    {
+      ReferenceSetBlock(x, y, font->chars + (*str - ' ') * (((font->h + 7) / 8) * font->w), font->w, font->h,
+                        OLED_COLOR_NORMAL);
+    }
+  }
+
+  // 逐像素的参考实现(原OLED_DrawFilledRectangle/OLED_DrawFilledCircle)
+  void ReferenceFilledRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, OLED_ColorMode color)
+  {
+    for (uint8_t i = 0; i < h; i++)
+    {
+      for (uint8_t j = x; j <= x + w; j++)
+      {
+        OLED_SetPixel(j, y + i, color);
+      }
+    }
+  }
+
+  void ReferenceFilledCircle(uint8_t x, uint8_t y, uint8_t r, OLED_ColorMode color)
+  {
+    int16_t a = 0, b = r, di = 3 - (r << 1);
+    while (a <= b)
+    {
+      for (int16_t i = x - b; i <= x + b; i++)
+      {
+        OLED_SetPixel(i, y + a, color);
+        OLED_SetPixel(i, y - a, color);
+      }
+      for (int16_t i = x - a; i <= x + a; i++)
+      {
+        OLED_SetPixel(i, y + b, color);
+        OLED_SetPixel(i, y - b, color);
+      }
+      a++;
+      if (di < 0)
+      {
+        di += 4 * a + 6;
+      }
+      else
+      {
+        di += 10 + 4 * (a - b);
+        b--;
+      }
+    }
+  }
+
+  // 进度条和倒计时圆, 每轮改变进度使显存确有变化
+  void ReferenceShapes(int r)
+  {
+    uint8_t progress = r % 120;
+    ReferenceFilledRectangle(4, 56, progress, 6, OLED_COLOR_NORMAL);
+    ReferenceFilledRectangle(4 + progress, 56, 120 - progress, 6, OLED_COLOR_REVERSED);
+    ReferenceFilledCircle(108, 20, 12, (r & 1) ? OLED_COLOR_NORMAL : OLED_COLOR_REVERSED);
+  }
+
+  void SpanShapes(int r)
+  {
+    uint8_t progress = r % 120;
+    OLED_DrawFilledRectangle(4, 56, progress, 6, OLED_COLOR_NORMAL);
+    OLED_DrawFilledRectangle(4 + progress, 56, 120 - progress, 6, OLED_COLOR_REVERSED);
+    OLED_DrawFilledCircle(108, 20, 12, (r & 1) ? OLED_COLOR_NORMAL : OLED_COLOR_REVERSED);
+  }
+
+  // 返回每轮的平均耗时(ns)
+  double RunShapes(void (*draw)(int), int rounds)
+  {
+    uint64_t start = NowNs();
+    for (int r = 0; r < rounds; r++)
+    {
+      draw(r);
+    }
+    return static_cast<double>(NowNs() - start) / rounds;
+  }
+
+  // 各图元, 参数随轮数变化, 避免每次写入相同内容被跳过
+  void Pixel(int r) { OLED_SetPixel(r % 128, r % 64, (r & 64) ? OLED_COLOR_REVERSED : OLED_COLOR_NORMAL); }
+  void Line(int r) { OLED_DrawLine(0, r % 64, 127, 63 - r % 64, OLED_COLOR_NORMAL); }
+  void HLine(int r) { OLED_DrawHLine(0, r % 64, 128, (r & 64) ? OLED_COLOR_REVERSED : OLED_COLOR_NORMAL); }
+  void Rectangle(int r) { OLED_DrawRectangle(r % 32, r % 16, 64, 32, OLED_COLOR_NORMAL); }
+  void FilledRectangle(int r) { OLED_DrawFilledRectangle(r % 32, r % 16, 64, 32, OLED_COLOR_NORMAL); }
+  void Circle(int r) { OLED_DrawCircle(64, 32, 10 + r % 20, OLED_COLOR_NORMAL); }
+  void FilledCircle(int r) { OLED_DrawFilledCircle(64, 32, 10 + r % 20, OLED_COLOR_NORMAL); }
+  void Triangle(int r) { OLED_DrawTriangle(r % 32, 60, 64, 4, 127 - r % 32, 60, OLED_COLOR_NORMAL); }
+  void FilledTriangle(int r) { OLED_DrawFilledTriangle(r % 32, 60, 64, 4, 127 - r % 32, 60, OLED_COLOR_NORMAL); }
+  void Ellipse(int r) { OLED_DrawEllipse(64, 32, 20 + r % 40, 10 + r % 20, OLED_COLOR_NORMAL); }
+  void AsciiString(int r)
+  {
+    OLED_PrintASCIIString(r % 8, 24, const_cast<char *>("12345"), &afont16x8, OLED_COLOR_NORMAL);
+  }
+  void ChineseString(int r)
+  {
+    OLED_PrintString(r % 8, 24, const_cast<char *>("MANPOINT:"), &font16x16, OLED_COLOR_NORMAL);
+  }
+
+  // 一帧完整的状态画面: 清屏、标签、三个数值框, 发布
+  void StatusFrame(int r)
+  {
+    static OledNumber time_field(60, 6, 68, &afont16x8);
+    static OledNumber manul_point_field(80, 24, 48, &afont16x8);
+    static OledNumber auto_point_field(90, 42, 38, &afont16x8);
+    OLED_NewFrame();
+    OLED_PrintString(0, 6, const_cast<char *>("TIME:"), &font16x16, OLED_COLOR_NORMAL);
+    OLED_PrintString(0, 24, const_cast<char *>("MANPOINT:"), &font16x16, OLED_COLOR_NORMAL);
+    OLED_PrintString(0, 42, const_cast<char *>("AUTOPOINT:"), &font16x16, OLED_COLOR_NORMAL);
+    time_field.Invalidate();
+    manul_point_field.Invalidate();
+    auto_point_field.Invalidate();
+    time_field.Set(r % 180);
+    manul_point_field.Set(r % 1000);
+    auto_point_field.Set(r % 100);
+    OLED_Publish();
+  }
+
+  // 曲线控件: 每次一个采样, 每20个采样滚动绘制一列
+  void Plot(int r)
+  {
+    static OledPlot plot(0, 0, 128, 64, -3000, 3000, 20);
+    plot.Push(r % 4000 - 2000, (r * 7) % 4000 - 2000);
+    plot.Draw();
+  }
+
+  struct Primitive
+  {
+    const char *name;
+    void (*draw)(int);
+  };
+
+  const Primitive kPrimitives[] = {
+      {"SetPixel", Pixel},
+      {"DrawLine", Line},
+      {"DrawHLine", HLine},
+      {"DrawRectangle", Rectangle},
+      {"DrawFilledRectangle", FilledRectangle},
+      {"DrawCircle", Circle},
+      {"DrawFilledCircle", FilledCircle},
+      {"DrawTriangle", Triangle},
+      {"DrawFilledTriangle", FilledTriangle},
+      {"DrawEllipse", Ellipse},
+      {"PrintASCIIString", AsciiString},
+      {"PrintString", ChineseString},
+      {"status frame", StatusFrame},
+      {"plot sample", Plot},
+  };
+
+  void BlockPrint(uint8_t x, uint8_t y, const char *str, const ASCIIFont *font)
+  {
+    OLED_PrintASCIIString(x, y, const_cast<char *>(str), font, OLED_COLOR_NORMAL);
+  }
+
+  // 返回每个字符串的平均耗时(ns)
+  double Run(void (*print)(uint8_t, uint8_t, const char *, const ASCIIFont *), int rounds)
+  {
+    // 预先生成字符串, 计时只包含绘制
+    static char texts[100][8];
+    for (int i = 0; i < 100; i++)
+    {
+      snprintf(texts[i], sizeof(texts[i]), "%05d", i * 7919);
+    }
+
+    uint64_t start = NowNs();
+    for (int r = 0; r < rounds; r++)
+    {
+      for (const TextLine &line : kLines)
+      {
+        print(line.x, line.y, texts[r % 100], &afont16x8);
+      }
+    }
+    return static_cast<double>(NowNs() - start) / (static_cast<double>(rounds) * 3);
+  }
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  int rounds = argc > 1 ? atoi(argv[1]) : 20000;
+  if (rounds <= 0) rounds = 20000;
+
+  OLED_NewFrame();
+  double reference_ns = Run(ReferencePrint, rounds);
+  OLED_NewFrame();
+  double block_ns = Run(BlockPrint, rounds);
+
+  printf("%d strings of 5 chars (afont16x8, y = 6/24/42)\n", rounds * 3);
+  printf("per-byte  %8.1f ns/string\n", reference_ns);
+  printf("blitter   %8.1f ns/string\n", block_ns);
+  printf("speedup   %8.1fx\n", reference_ns / block_ns);
+
+  OLED_NewFrame();
+  double reference_shapes_ns = RunShapes(ReferenceShapes, rounds);
+  OLED_NewFrame();
+  double span_shapes_ns = RunShapes(SpanShapes, rounds);
+
+  printf("%d frames of progress bar (120x6) + filled circle (r=12)\n", rounds);
+  printf("per-pixel %8.1f ns/frame\n", reference_shapes_ns);
+  printf("spans     %8.1f ns/frame\n", span_shapes_ns);
+  printf("speedup   %8.1fx\n", reference_shapes_ns / span_shapes_ns);
+
+  printf("%d calls per primitive\n", rounds);
+  for (const Primitive &primitive : kPrimitives)
+  {
+    OLED_NewFrame();
+    printf("%-20s %8.1f ns\n", primitive.name, RunShapes(primitive.draw, rounds));
+  }
+  return 0;
+}
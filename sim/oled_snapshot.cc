@@ -0,0 +1,238 @@
+/**
+ * @file oled_snapshot.cc
+ * @brief OLED画面快照与回归比对
+ *
+ * @note
+ * 在主机上运行真实的OLED驱动, 经I2C替身把传输送入SSD1306仿真屏幕, 依次绘制各个画面,
+ * 每个画面发布并等待传输全部到达屏幕后, 从仿真屏幕取出画面写为PBM文件.
+ * 画面按固件的方式增量绘制(只发送脏区), 其中一个画面在传输中途注入I2C错误,
+ * 经总线恢复后完整重绘, 因此快照同时覆盖脏区窗口和恢复流程.
+ *
+ * 参考快照提交在sim/golden/, ctest用-c比对, 任何像素差异都会列出并返回1:
+ *   oled_snapshot sim/golden       # 画面有意改变时重新生成sim/golden/<画面>.pbm
+ *   oled_snapshot -c sim/golden    # 与参考快照比对
+ */
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "Format.h"
+#include "OledWidget.h"
+#include "i2c.h"
+#include "main.h"
+#include "oled.h"
+#include "sim.h"
+
+namespace
+{
+  // 与XYControlTask中的状态画面布局一致
+  OledNumber time_field(60, 6, 68, &afont16x8);
+  OledNumber manul_point_field(80, 24, 48, &afont16x8);
+  OledNumber auto_point_field(90, 42, 38, &afont16x8);
+
+  void StatusLabels()
+  {
+    OLED_NewFrame();
+    OLED_PrintString(0, 6, const_cast<char *>("TIME:"), &font16x16, OLED_COLOR_NORMAL);
+    OLED_PrintString(0, 24, const_cast<char *>("MANPOINT:"), &font16x16, OLED_COLOR_NORMAL);
+    OLED_PrintString(0, 42, const_cast<char *>("AUTOPOINT:"), &font16x16, OLED_COLOR_NORMAL);
+    time_field.Invalidate();
+    manul_point_field.Invalidate();
+    auto_point_field.Invalidate();
+  }
+
+  void StatusInit()
+  {
+    StatusLabels();
+    time_field.Set(0);
+    manul_point_field.Set(0);
+    auto_point_field.Set(0);
+  }
+
+  void StatusRunning()
+  {
+    time_field.Set(37);
+    manul_point_field.Set(12);
+    auto_point_field.Set(30);
+  }
+
+  void StatusOvertime() { time_field.SetText("OVERTIME"); }
+
+  void StatusRecovered()
+  {
+    // 本帧传输中途应答失败, 下一次刷新时恢复总线并完整重绘
+    SimInjectI2cErrors(1);
+    time_field.Set(5);
+    manul_point_field.Set(120);
+  }
+
+  // 各种图元和字号
+  void Primitives()
+  {
+    OLED_NewFrame();
+    OLED_DrawLine(0, 0, 40, 20, OLED_COLOR_NORMAL);
+    OLED_DrawLine(0, 20, 40, 0, OLED_COLOR_NORMAL);
+    OLED_DrawRectangle(44, 0, 20, 12, OLED_COLOR_NORMAL);
+    OLED_DrawFilledRectangle(47, 3, 14, 6, OLED_COLOR_NORMAL);
+    OLED_DrawCircle(78, 10, 9, OLED_COLOR_NORMAL);
+    OLED_DrawFilledCircle(78, 10, 4, OLED_COLOR_NORMAL);
+    OLED_DrawEllipse(108, 10, 18, 7, OLED_COLOR_NORMAL);
+    OLED_DrawTriangle(2, 46, 20, 24, 38, 46, OLED_COLOR_NORMAL);
+    OLED_DrawFilledTriangle(8, 44, 20, 30, 32, 44, OLED_COLOR_NORMAL);
+    OLED_PrintASCIIString(44, 22, const_cast<char *>("8x6"), &afont8x6, OLED_COLOR_NORMAL);
+    OLED_PrintASCIIString(66, 22, const_cast<char *>("12x6"), &afont12x6, OLED_COLOR_NORMAL);
+    OLED_PrintASCIIString(94, 22, const_cast<char *>("24"), &afont24x12, OLED_COLOR_NORMAL);
+    OLED_PrintASCIIString(44, 32, const_cast<char *>("16x8"), &afont16x8, OLED_COLOR_REVERSED);
+
+    OledBar bar(0, 52, 128, 12);
+    bar.Set(45, 100);
+  }
+
+  // 位置曲线: 目标阶跃, 实际值按二阶系统带超调地跟随
+  void Plot()
+  {
+    OLED_NewFrame();
+    OledPlot plot(0, 0, 128, 64, -3000, 3000, 20);
+    float position = 0, velocity = 0;
+    int32_t target = 0;
+    for (int i = 0; i < 4000; i++)
+    {
+      if (i == 1000) target = 2000;
+      if (i == 2600) target = -1500;
+      velocity += 0.0004f * (target - position) - 0.012f * velocity;
+      position += velocity;
+      plot.Push(target, static_cast<int32_t>(position));
+      plot.Draw();
+    }
+  }
+
+  struct Screen
+  {
+    const char *name;
+    void (*draw)();
+  };
+
+  // 按顺序增量绘制, 后一个画面在前一个的基础上修改
+  const Screen kScreens[] = {
+      {"status_init", StatusInit},
+      {"status_running", StatusRunning},
+      {"status_overtime", StatusOvertime},
+      {"status_recovered", StatusRecovered},
+      {"primitives", Primitives},
+      {"plot", Plot},
+  };
+
+  // 刷新直到队列中的传输全部到达屏幕
+  bool ShowAndWait(uint32_t timeout)
+  {
+    uint64_t last = SimOledReceivedBytes();
+    uint32_t start = HAL_GetTick();
+    uint32_t settled = start;
+    while (HAL_GetTick() - start < timeout)
+    {
+      OLED_ShowFrame();
+      usleep(1000);
+      OLED_Stats stats;
+      OLED_GetStats(&stats);
+      uint64_t received = SimOledReceivedBytes();
+      // 上一次传输刚好完成时本帧可能还未放入队列, 还要确认没有待发送的页
+      if (received == stats.bytes && !OLED_PendingPages() && !OLED_IsBusy()) return true;
+
+      // 出错后被丢弃的传输不会到达屏幕: 超过恢复间隔仍没有新数据到达, 说明恢复和重绘已完成
+      if (received != last)
+      {
+        last = received;
+        settled = HAL_GetTick();
+      }
+      else if (HAL_GetTick() - settled > 300)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadPbm(const char *path, uint8_t image[64][128])
+  {
+    FILE *file = fopen(path, "r");
+    if (!file) return false;
+    unsigned w = 0, h = 0;
+    bool ok = fscanf(file, "P1 %u %u", &w, &h) == 2 && w == 128 && h == 64;
+    for (int i = 0; ok && i < 64 * 128; i++)
+    {
+      int c;
+      do
+      {
+        c = fgetc(file);
+      } while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+      ok = c == '0' || c == '1';
+      image[i / 128][i % 128] = c == '1';
+    }
+    fclose(file);
+    return ok;
+  }
+}  // namespace
+
+int main(int argc, char **argv)
+{
+  bool check = argc > 2 && strcmp(argv[1], "-c") == 0;
+  const char *dir = check ? argv[2] : (argc > 1 ? argv[1] : nullptr);
+  if (!dir)
+  {
+    fprintf(stderr, "usage: oled_snapshot [-c] DIR\n");
+    return 2;
+  }
+
+  OLED_Init();
+
+  int failures = 0;
+  for (const Screen &screen : kScreens)
+  {
+    screen.draw();
+    OLED_Publish();
+    if (!ShowAndWait(2000))
+    {
+      printf("%-18s transfer did not settle\n", screen.name);
+      failures++;
+      continue;
+    }
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.pbm", dir, screen.name);
+    if (!check)
+    {
+      bool ok = SimOledWritePbm(path);
+      printf("%-18s %s\n", screen.name, ok ? path : "write failed");
+      failures += !ok;
+      continue;
+    }
+
+    static uint8_t expected[64][128], actual[64][128];
+    SimOledGetImage(actual);
+    if (!ReadPbm(path, expected))
+    {
+      printf("%-18s cannot read %s\n", screen.name, path);
+      failures++;
+      continue;
+    }
+    int diff = 0;
+    for (int y = 0; y < 64; y++)
+    {
+      for (int x = 0; x < 128; x++)
+      {
+        diff += expected[y][x] != actual[y][x];
+      }
+    }
+    char count[12];
+    FormatUInt(count, sizeof(count), static_cast<uint32_t>(diff));
+    printf("%-18s %s\n", screen.name, diff ? count : "ok");
+    failures += diff != 0;
+  }
+
+  OLED_Stats stats;
+  OLED_GetStats(&stats);
+  printf("%lu bytes, %lu errors, %lu recoveries\n", static_cast<unsigned long>(stats.bytes),
+         static_cast<unsigned long>(stats.errors), static_cast<unsigned long>(stats.recoveries));
+  return failures ? 1 : 0;
+}
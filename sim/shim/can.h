@@ -0,0 +1,8 @@
+#ifndef SIM_CAN_H
+#define SIM_CAN_H
+
+// librm在Linux平台上的rm::hal::Can由SocketCAN实现, 句柄即为网卡名
+extern const char *const hcan1;  // 电机总线, 默认vcan0
+extern const char *const hcan2;  // 遥测总线, 默认vcan1
+
+#endif /* SIM_CAN_H */
@@ -0,0 +1,71 @@
+#ifndef SIM_CMSIS_OS_H
+#define SIM_CMSIS_OS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define osWaitForever 0xFFFFFFFF
+
+  typedef enum
+  {
+    osOK = 0,
+    osEventSignal = 0x08,
+    osEventMessage = 0x10,
+    osEventTimeout = 0x40,
+    osErrorParameter = 0x80,
+    osErrorOS = 0xFF
+  } osStatus;
+
+  typedef struct SimThread *osThreadId;
+  typedef struct SimMessageQueue *osMessageQId;
+
+  typedef struct
+  {
+    uint32_t queue_sz;
+    uint32_t item_sz;
+  } osMessageQDef_t;
+
+  typedef struct
+  {
+    osStatus status;
+    union
+    {
+      uint32_t v;
+      int32_t signals;
+    } value;
+  } osEvent;
+
+#define osMessageQDef(name, queue_sz, type) const osMessageQDef_t os_messageQ_def_##name = {(queue_sz), sizeof(type)}
+#define osMessageQ(name) &os_messageQ_def_##name
+
+  /**
+   * @brief 以绝对时刻休眠, 同时统计调用线程每个周期的执行时间
+   */
+  osStatus osDelay(uint32_t millisec);
+
+  osThreadId osThreadGetId(void);
+
+  /**
+   * @brief 与FreeRTOS的任务通知一致: 信号在等待之前到达时保留, 可在"中断"中调用
+   */
+  int32_t osSignalSet(osThreadId thread_id, int32_t signals);
+
+  /**
+   * @brief 等待任意信号, 返回时清除signals中的位; 与osDelay一样统计本次唤醒后的执行时间
+   */
+  osEvent osSignalWait(int32_t signals, uint32_t millisec);
+
+  // 只支持32位消息
+  osMessageQId osMessageCreate(const osMessageQDef_t *queue_def, osThreadId thread_id);
+  osStatus osMessagePut(osMessageQId queue_id, uint32_t info, uint32_t millisec);
+  osEvent osMessageGet(osMessageQId queue_id, uint32_t millisec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_CMSIS_OS_H */
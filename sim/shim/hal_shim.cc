@@ -0,0 +1,379 @@
+/**
+ * @file hal_shim.cc
+ * @brief 主机仿真的HAL/CMSIS-RTOS替身实现
+ */
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "can.h"
+#include "cmsis_os.h"
+#include "i2c.h"
+#include "main.h"
+#include "sim.h"
+#include "usart.h"
+
+GPIO_TypeDef sim_gpio[9];
+I2C_HandleTypeDef hi2c2;
+UART_HandleTypeDef huart1;
+
+const char *const hcan1 = "vcan0";
+const char *const hcan2 = "vcan1";
+
+namespace
+{
+  std::recursive_mutex irq_lock;
+  std::atomic<uint32_t> button_release_tick{0};
+
+  uint64_t NowUs()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+  }
+
+  const uint64_t start_us = NowUs();
+
+  // 每个线程的周期执行时间统计
+  std::mutex stats_lock;
+  SimLoopStats stats[SIM_MAX_THREADS];
+  int stats_count = 0;
+
+  // I2C传输模拟: 400kHz下每字节9个时钟
+  const uint64_t kI2cByteUs = 23;
+
+  // 完成线程在进程退出时仍在等待, 二者不析构, 否则析构条件变量会一直等待该线程
+  std::mutex &i2c_lock = *new std::mutex;
+  std::condition_variable &i2c_cv = *new std::condition_variable;
+  uint64_t i2c_done_us = 0;           // 当前DMA传输完成时刻, 0表示空闲
+  const uint8_t *i2c_data = nullptr;  // 当前DMA传输的数据, 完成时送入仿真屏幕
+  uint16_t i2c_size = 0;
+  uint32_t i2c_generation = 0;
+  std::atomic<uint32_t> i2c_inject_errors{0};
+
+  void I2cCompletionThread()
+  {
+    std::unique_lock<std::mutex> lock(i2c_lock);
+    for (;;)
+    {
+      i2c_cv.wait(lock, [] { return i2c_done_us != 0; });
+      uint64_t done = i2c_done_us;
+      uint32_t generation = i2c_generation;
+      lock.unlock();
+      uint64_t now = NowUs();
+      if (done > now)
+      {
+        timespec ts = {static_cast<time_t>((done - now) / 1000000), static_cast<long>((done - now) % 1000000) * 1000};
+        nanosleep(&ts, nullptr);
+      }
+      lock.lock();
+      // 传输期间外设被复位则不再产生完成中断
+      if (generation != i2c_generation || i2c_done_us == 0) continue;
+      i2c_done_us = 0;
+      const uint8_t *data = i2c_data;
+      uint16_t size = i2c_size;
+      lock.unlock();
+
+      // 完成回调在"中断"上下文中执行, 其中可能启动下一次传输; 应答失败的传输不到达屏幕
+      uint32_t inject = i2c_inject_errors.load();
+      bool fail = inject > 0 && i2c_inject_errors.compare_exchange_strong(inject, inject - 1);
+      if (!fail) SimOledWrite(data, size);
+      irq_lock.lock();
+      if (fail)
+      {
+        HAL_I2C_ErrorCallback(&hi2c2);
+      }
+      else
+      {
+        HAL_I2C_MasterTxCpltCallback(&hi2c2);
+      }
+      irq_lock.unlock();
+      lock.lock();
+    }
+  }
+
+  thread_local int stats_index = -1;
+  thread_local uint64_t wake_us = 0;  // 本周期唤醒时刻
+
+  // 记录调用线程从上次唤醒到现在的执行时间, period_us为0时不统计超时
+  void RecordBusy(uint64_t now, uint64_t period_us)
+  {
+    if (stats_index < 0 || wake_us == 0) return;
+    std::lock_guard<std::mutex> guard(stats_lock);
+    SimLoopStats &s = stats[stats_index];
+    uint64_t busy = now - wake_us;
+    s.cycles++;
+    s.busy_us_total += busy;
+    if (busy > s.busy_us_max) s.busy_us_max = busy;
+    if (period_us && busy > period_us) s.overruns++;
+  }
+
+  // 与FreeRTOS一致, 超时在第millisec个系统节拍处结束, 各线程对齐到同一节拍
+  uint64_t TickDeadline(uint64_t now, uint32_t millisec)
+  {
+    return start_us + ((now - start_us) / 1000 + millisec) * 1000;
+  }
+
+  std::chrono::steady_clock::time_point ToTimePoint(uint64_t us)
+  {
+    return std::chrono::steady_clock::time_point(std::chrono::microseconds(us));
+  }
+}  // namespace
+
+// 任务通知
+struct SimThread
+{
+  std::mutex lock;
+  std::condition_variable cv;
+  uint32_t signals = 0;
+  bool notified = false;
+};
+
+struct SimMessageQueue
+{
+  std::mutex lock;
+  std::condition_variable cv;
+  std::deque<uint32_t> items;
+  uint32_t size;
+};
+
+namespace
+{
+  thread_local SimThread current_thread;
+}  // namespace
+
+extern "C"
+{
+  uint32_t HAL_GetTick(void) { return static_cast<uint32_t>((NowUs() - start_us) / 1000); }
+
+  void HAL_Delay(uint32_t delay)
+  {
+    timespec ts = {static_cast<time_t>(delay / 1000), static_cast<long>(delay % 1000) * 1000000};
+    nanosleep(&ts, nullptr);
+  }
+
+  void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+  {
+    static uint16_t last_state[9];
+    int index = port - sim_gpio;
+    uint16_t next = state ? (last_state[index] | pin) : (last_state[index] & ~pin);
+    if (next != last_state[index])
+    {
+      fprintf(stderr, "[%7lu] GPIO%c 0x%04x -> %s\n", static_cast<unsigned long>(HAL_GetTick()), 'A' + index, pin,
+              state ? "SET" : "RESET");
+      last_state[index] = next;
+    }
+  }
+
+  GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin)
+  {
+    // 微动开关(PI9)低电平有效
+    if (port == GPIOI && pin == GPIO_PIN_9 && HAL_GetTick() < button_release_tick.load())
+    {
+      return GPIO_PIN_RESET;
+    }
+    return GPIO_PIN_SET;
+  }
+
+  void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init)
+  {
+    (void)port;
+    (void)init;
+  }
+
+  // 与HAL相同, 未使用EXTI的程序(如oled_bench)使用空的弱定义
+  __attribute__((weak)) void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) { (void)GPIO_Pin; }
+
+  void __disable_irq(void) { irq_lock.lock(); }
+
+  void __enable_irq(void) { irq_lock.unlock(); }
+
+  HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t address, uint8_t *data, uint16_t size,
+                                            uint32_t timeout)
+  {
+    (void)address;
+    (void)timeout;
+    hi2c->tx_bytes += size;
+    SimOledWrite(data, size);
+
+    // 轮询发送期间CPU一直等待
+    uint64_t done = NowUs() + size * kI2cByteUs;
+    while (NowUs() < done)
+    {
+    }
+    return HAL_OK;
+  }
+
+  HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t address, uint8_t *data,
+                                                uint16_t size)
+  {
+    (void)address;
+    static std::once_flag started;
+    std::call_once(started, [] { std::thread(I2cCompletionThread).detach(); });
+
+    std::lock_guard<std::mutex> guard(i2c_lock);
+    if (i2c_done_us != 0) return HAL_BUSY;
+    hi2c->tx_bytes += size;
+    i2c_data = data;
+    i2c_size = size;
+    i2c_done_us = NowUs() + size * kI2cByteUs;
+    i2c_cv.notify_one();
+    return HAL_OK;
+  }
+
+  HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+  {
+    (void)hi2c;
+    std::lock_guard<std::mutex> guard(i2c_lock);
+    i2c_done_us = 0;
+    i2c_generation++;
+    return HAL_OK;
+  }
+
+  void MX_I2C2_Init(void) {}
+
+  osStatus osDelay(uint32_t millisec)
+  {
+    uint64_t now = NowUs();
+    RecordBusy(now, millisec * 1000ULL);
+
+    // 与FreeRTOS的vTaskDelay一致: 在当前节拍之后的第millisec个节拍唤醒
+    uint64_t wake = TickDeadline(now, millisec);
+    timespec next_wake = {static_cast<time_t>(wake / 1000000), static_cast<long>(wake % 1000000) * 1000};
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_wake, nullptr);
+
+    wake_us = NowUs();
+    return osOK;
+  }
+
+  osThreadId osThreadGetId(void) { return &current_thread; }
+
+  int32_t osSignalSet(osThreadId thread_id, int32_t signals)
+  {
+    std::lock_guard<std::mutex> guard(thread_id->lock);
+    int32_t previous = static_cast<int32_t>(thread_id->signals);
+    thread_id->signals |= static_cast<uint32_t>(signals);
+    thread_id->notified = true;
+    thread_id->cv.notify_one();
+    return previous;
+  }
+
+  osEvent osSignalWait(int32_t signals, uint32_t millisec)
+  {
+    uint64_t now = NowUs();
+    RecordBusy(now, 0);
+
+    SimThread &self = current_thread;
+    std::unique_lock<std::mutex> lock(self.lock);
+    if (millisec == osWaitForever)
+    {
+      self.cv.wait(lock, [&self] { return self.notified; });
+    }
+    else
+    {
+      self.cv.wait_until(lock, ToTimePoint(TickDeadline(now, millisec)), [&self] { return self.notified; });
+    }
+
+    osEvent event;
+    event.status = self.notified ? osEventSignal : osEventTimeout;
+    event.value.signals = static_cast<int32_t>(self.signals);
+    self.signals &= ~static_cast<uint32_t>(signals);
+    self.notified = false;
+    lock.unlock();
+
+    wake_us = NowUs();
+    return event;
+  }
+
+  osMessageQId osMessageCreate(const osMessageQDef_t *queue_def, osThreadId thread_id)
+  {
+    (void)thread_id;
+    SimMessageQueue *queue = new SimMessageQueue;
+    queue->size = queue_def->queue_sz;
+    return queue;
+  }
+
+  osStatus osMessagePut(osMessageQId queue_id, uint32_t info, uint32_t millisec)
+  {
+    (void)millisec;
+    std::lock_guard<std::mutex> guard(queue_id->lock);
+    if (queue_id->items.size() >= queue_id->size) return osErrorOS;
+    queue_id->items.push_back(info);
+    queue_id->cv.notify_one();
+    return osOK;
+  }
+
+  osEvent osMessageGet(osMessageQId queue_id, uint32_t millisec)
+  {
+    osEvent event;
+    event.value.v = 0;
+    std::unique_lock<std::mutex> lock(queue_id->lock);
+    auto ready = [queue_id] { return !queue_id->items.empty(); };
+    if (millisec == osWaitForever)
+    {
+      queue_id->cv.wait(lock, ready);
+    }
+    else if (millisec != 0)
+    {
+      queue_id->cv.wait_until(lock, ToTimePoint(TickDeadline(NowUs(), millisec)), ready);
+    }
+
+    if (queue_id->items.empty())
+    {
+      event.status = millisec ? osEventTimeout : osOK;
+      return event;
+    }
+    event.status = osEventMessage;
+    event.value.v = queue_id->items.front();
+    queue_id->items.pop_front();
+    return event;
+  }
+}
+
+void SimRegisterThread(const char *name)
+{
+  std::lock_guard<std::mutex> guard(stats_lock);
+  if (stats_count >= SIM_MAX_THREADS) return;
+  stats_index = stats_count++;
+  stats[stats_index] = SimLoopStats{};
+  stats[stats_index].name = name;
+}
+
+int SimTakeLoopStats(SimLoopStats *out, int max)
+{
+  std::lock_guard<std::mutex> guard(stats_lock);
+  int n = stats_count < max ? stats_count : max;
+  for (int i = 0; i < n; i++)
+  {
+    out[i] = stats[i];
+    const char *name = stats[i].name;
+    stats[i] = SimLoopStats{};
+    stats[i].name = name;
+  }
+  return n;
+}
+
+void SimPressButton(uint32_t duration)
+{
+  // 按下和松开各产生一次EXTI中断, 回调在"中断"上下文中执行
+  button_release_tick.store(HAL_GetTick() + duration);
+  irq_lock.lock();
+  HAL_GPIO_EXTI_Callback(GPIO_PIN_9);
+  irq_lock.unlock();
+  std::thread([duration] {
+    // 多等1ms, 保证回调中读到的引脚已是松开
+    timespec ts = {static_cast<time_t>((duration + 1) / 1000), static_cast<long>((duration + 1) % 1000) * 1000000};
+    nanosleep(&ts, nullptr);
+    irq_lock.lock();
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_9);
+    irq_lock.unlock();
+  }).detach();
+}
+
+void SimInjectI2cErrors(uint32_t count) { i2c_inject_errors.store(count); }
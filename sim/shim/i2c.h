@@ -0,0 +1,34 @@
+#ifndef SIM_I2C_H
+#define SIM_I2C_H
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  typedef struct
+  {
+    uint32_t tx_bytes;  // 累计发送字节数
+  } I2C_HandleTypeDef;
+
+  extern I2C_HandleTypeDef hi2c2;
+
+  void MX_I2C2_Init(void);
+
+  // 按400kHz总线时序模拟传输耗时: 阻塞发送占用调用线程, DMA发送在后台线程中完成并调用完成回调
+  HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t address, uint8_t *data, uint16_t size,
+                                            uint32_t timeout);
+  HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t address, uint8_t *data,
+                                                uint16_t size);
+  HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+
+  void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+  void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_I2C_H */
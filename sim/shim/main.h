@@ -0,0 +1,86 @@
+#ifndef SIM_MAIN_H
+#define SIM_MAIN_H
+
+/**
+ * @brief 主机仿真用的main.h替身
+ * @note  只提供应用层用到的HAL符号, GPIO输出记录到日志, 微动开关由SIGUSR1模拟(按下和松开时产生EXTI回调)
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  typedef enum
+  {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+  } HAL_StatusTypeDef;
+
+  typedef enum
+  {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+  } GPIO_PinState;
+
+  typedef struct
+  {
+    char port;
+  } GPIO_TypeDef;
+
+  extern GPIO_TypeDef sim_gpio[];
+
+#define GPIOA (&sim_gpio[0])
+#define GPIOB (&sim_gpio[1])
+#define GPIOE (&sim_gpio[4])
+#define GPIOF (&sim_gpio[5])
+#define GPIOH (&sim_gpio[7])
+#define GPIOI (&sim_gpio[8])
+
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+#define GPIO_PIN_1 ((uint16_t)0x0002)
+#define GPIO_PIN_2 ((uint16_t)0x0004)
+#define GPIO_PIN_3 ((uint16_t)0x0008)
+#define GPIO_PIN_4 ((uint16_t)0x0010)
+#define GPIO_PIN_5 ((uint16_t)0x0020)
+#define GPIO_PIN_6 ((uint16_t)0x0040)
+#define GPIO_PIN_9 ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+
+#define GPIO_MODE_OUTPUT_OD 0x00000011U
+#define GPIO_NOPULL 0x00000000U
+#define GPIO_SPEED_FREQ_VERY_HIGH 0x00000003U
+
+  typedef struct
+  {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+  } GPIO_InitTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+#define UNUSED(X) (void)X
+
+  uint32_t HAL_GetTick(void);
+  void HAL_Delay(uint32_t delay);
+  void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+  GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin);
+  void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+  void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+  // 仿真中用全局锁代替关中断
+  void __disable_irq(void);
+  void __enable_irq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_MAIN_H */
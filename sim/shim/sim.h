@@ -0,0 +1,42 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+#define SIM_MAX_THREADS 4
+
+// 线程周期执行时间统计
+struct SimLoopStats
+{
+  const char *name;
+  uint64_t cycles;         // 周期数
+  uint64_t busy_us_total;  // 累计执行时间(us)
+  uint64_t busy_us_max;    // 最大单周期执行时间(us)
+  uint64_t overruns;       // 执行时间超过周期的次数
+};
+
+// 为调用线程登记统计槽位
+void SimRegisterThread(const char *name);
+
+// 取出并清零各线程统计, 返回线程数
+int SimTakeLoopStats(SimLoopStats *out, int max);
+
+// 模拟按下微动开关duration毫秒
+void SimPressButton(uint32_t duration);
+
+// 之后count次I2C DMA传输以应答失败结束(模拟屏幕掉电或干扰)
+void SimInjectI2cErrors(uint32_t count);
+
+// SSD1306仿真(ssd1306.cc): I2C替身把发送成功的传输(首字节为控制字节)送入仿真屏幕
+void SimOledWrite(const uint8_t *data, uint16_t size);
+
+// 仿真屏幕累计收到的字节数, 与OLED_Stats.bytes相等时队列中的传输已全部到达屏幕
+uint64_t SimOledReceivedBytes();
+
+// 取出屏幕当前画面, 每像素一字节(1亮 0灭)
+void SimOledGetImage(uint8_t image[64][128]);
+
+// 屏幕当前画面写为PBM(P1)文件
+bool SimOledWritePbm(const char *path);
+
+#endif /* SIM_H */
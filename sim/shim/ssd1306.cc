@@ -0,0 +1,244 @@
+/**
+ * @file ssd1306.cc
+ * @brief 主机仿真的SSD1306屏幕
+ *
+ * @note
+ * I2C替身把发送成功的每次传输交给SimOledWrite(), 这里按SSD1306的协议解析:
+ * 首字节为控制字节(0x00指令流, 0x40数据流), 指令维护寻址模式、列/页窗口和显示状态,
+ * 数据按当前寻址模式写入128x8页的GDDRAM并推进地址. 画面按段重映射/COM扫描方向/起始行
+ * 从GDDRAM还原, 与屏幕上看到的一致(A1+C8为正向).
+ * 只实现oled.cc和常见初始化序列用到的指令, 滚动等指令只解析参数而不生效.
+ */
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include "sim.h"
+
+namespace
+{
+  const uint8_t kColumns = 128;
+  const uint8_t kPages = 8;
+  const uint8_t kRows = 64;
+
+  struct Panel
+  {
+    uint8_t ram[kPages][kColumns];
+    uint8_t mode = 0x02;  // 复位后为页寻址模式
+    uint8_t column_start = 0, column_end = kColumns - 1;
+    uint8_t page_start = 0, page_end = kPages - 1;
+    uint8_t column = 0, page = 0;
+    uint8_t start_line = 0;
+    bool display_on = false;
+    bool entire_on = false;  // A5: 忽略GDDRAM全部点亮
+    bool inverted = false;
+    bool segment_remap = false;
+    bool com_remap = false;
+
+    // 多字节指令的解析状态
+    uint8_t command = 0;
+    uint8_t args[6];
+    uint8_t args_needed = 0;
+    uint8_t args_count = 0;
+  };
+
+  std::mutex panel_lock;
+  Panel panel;
+  uint64_t received_bytes = 0;
+
+  // 指令的参数字节数
+  uint8_t ArgCount(uint8_t cmd)
+  {
+    switch (cmd)
+    {
+      case 0x20:
+      case 0x81:
+      case 0x8D:
+      case 0xA8:
+      case 0xD3:
+      case 0xD5:
+      case 0xD9:
+      case 0xDA:
+      case 0xDB:
+        return 1;
+      case 0x21:
+      case 0x22:
+      case 0xA3:
+        return 2;
+      case 0x29:
+      case 0x2A:
+        return 5;
+      case 0x26:
+      case 0x27:
+        return 6;
+      default:
+        return 0;
+    }
+  }
+
+  void Execute(Panel &p)
+  {
+    uint8_t cmd = p.command;
+    if (cmd <= 0x0F)
+    {
+      p.column = (p.column & 0xF0) | cmd;
+    }
+    else if (cmd <= 0x1F)
+    {
+      p.column = ((cmd & 0x07) << 4) | (p.column & 0x0F);
+    }
+    else if (cmd >= 0x40 && cmd <= 0x7F)
+    {
+      p.start_line = cmd & 0x3F;
+    }
+    else if (cmd >= 0xB0 && cmd <= 0xB7)
+    {
+      p.page = cmd & 0x07;
+    }
+    else
+    {
+      switch (cmd)
+      {
+        case 0x20:
+          p.mode = p.args[0] & 0x03;
+          break;
+        case 0x21:
+          p.column_start = p.args[0] & 0x7F;
+          p.column_end = p.args[1] & 0x7F;
+          p.column = p.column_start;
+          break;
+        case 0x22:
+          p.page_start = p.args[0] & 0x07;
+          p.page_end = p.args[1] & 0x07;
+          p.page = p.page_start;
+          break;
+        case 0xA0:
+        case 0xA1:
+          p.segment_remap = cmd & 0x01;
+          break;
+        case 0xA4:
+        case 0xA5:
+          p.entire_on = cmd & 0x01;
+          break;
+        case 0xA6:
+        case 0xA7:
+          p.inverted = cmd & 0x01;
+          break;
+        case 0xAE:
+        case 0xAF:
+          p.display_on = cmd & 0x01;
+          break;
+        case 0xC0:
+        case 0xC8:
+          p.com_remap = cmd & 0x08;
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  void WriteCommand(Panel &p, uint8_t byte)
+  {
+    if (p.args_needed == 0)
+    {
+      p.command = byte;
+      p.args_needed = ArgCount(byte);
+      p.args_count = 0;
+    }
+    else
+    {
+      p.args[p.args_count++] = byte;
+    }
+    if (p.args_count == p.args_needed)
+    {
+      p.args_needed = 0;
+      Execute(p);
+    }
+  }
+
+  void WriteData(Panel &p, uint8_t byte)
+  {
+    p.ram[p.page][p.column] = byte;
+    if (p.mode == 0x00)  // 水平寻址: 列到窗口右边界后换页
+    {
+      if (p.column++ >= p.column_end)
+      {
+        p.column = p.column_start;
+        p.page = p.page >= p.page_end ? p.page_start : p.page + 1;
+      }
+    }
+    else if (p.mode == 0x01)  // 垂直寻址: 页到窗口下边界后换列
+    {
+      if (p.page++ >= p.page_end)
+      {
+        p.page = p.page_start;
+        p.column = p.column >= p.column_end ? p.column_start : p.column + 1;
+      }
+    }
+    else  // 页寻址: 只推进列, 不换页
+    {
+      p.column = (p.column + 1) % kColumns;
+    }
+  }
+}  // namespace
+
+void SimOledWrite(const uint8_t *data, uint16_t size)
+{
+  if (size == 0) return;
+  std::lock_guard<std::mutex> guard(panel_lock);
+  bool is_data = data[0] & 0x40;
+  for (uint16_t i = 1; i < size; i++)
+  {
+    if (is_data)
+    {
+      WriteData(panel, data[i]);
+    }
+    else
+    {
+      WriteCommand(panel, data[i]);
+    }
+  }
+  received_bytes += size;
+}
+
+uint64_t SimOledReceivedBytes()
+{
+  std::lock_guard<std::mutex> guard(panel_lock);
+  return received_bytes;
+}
+
+void SimOledGetImage(uint8_t image[64][128])
+{
+  std::lock_guard<std::mutex> guard(panel_lock);
+  for (uint8_t y = 0; y < kRows; y++)
+  {
+    // C8时COM63~COM0自上而下, A1时SEG0对应第127列; 二者同时设置为正向
+    uint8_t row = (uint8_t)(((panel.com_remap ? y : kRows - 1 - y) + panel.start_line) % kRows);
+    for (uint8_t x = 0; x < kColumns; x++)
+    {
+      uint8_t column = panel.segment_remap ? x : kColumns - 1 - x;
+      uint8_t on = panel.entire_on || (panel.ram[row / 8][column] >> (row % 8) & 1);
+      image[y][x] = panel.display_on && (on ^ panel.inverted);
+    }
+  }
+}
+
+bool SimOledWritePbm(const char *path)
+{
+  static uint8_t image[64][128];
+  SimOledGetImage(image);
+
+  FILE *file = fopen(path, "w");
+  if (!file) return false;
+  fprintf(file, "P1\n%u %u\n", kColumns, kRows);
+  for (uint8_t y = 0; y < kRows; y++)
+  {
+    for (uint8_t x = 0; x < kColumns; x++)
+    {
+      fputc(image[y][x] ? '1' : '0', file);
+    }
+    fputc('\n', file);
+  }
+  return fclose(file) == 0;
+}
@@ -0,0 +1,14 @@
+#ifndef SIM_USART_H
+#define SIM_USART_H
+
+#include "main.h"
+
+// 仿真中没有USART1, 遥控器帧由host_main直接送入RemoteReceiver::Feed
+typedef struct
+{
+  int instance;
+} UART_HandleTypeDef;
+
+extern UART_HandleTypeDef huart1;
+
+#endif /* SIM_USART_H */
@@ -0,0 +1,111 @@
+/**
+ * @file teleop_test.cc
+ * @brief 手控点动到位测试
+ *
+ * @note
+ * 用与XYControlTask::UpdatePosition相同的量化位置(转子每转一圈位置变化一格, x轴14/36mm, y轴8/36mm)
+ * 闭环运行Teleop, 每轴点动一步, 检查点动结束后输出归零、位置停在一步附近且不再变化.
+ * 电机按理想速度环处理, 转速即为Teleop输出的目标转速; 系统节拍由本文件提供, 每个控制周期前进1ms.
+ *
+ * 用法: teleop_test, 失败时返回1
+ */
+#include <cmath>
+#include <cstdio>
+
+#include "Teleop.h"
+#include "main.h"
+
+namespace
+{
+  uint32_t tick = 0;
+
+  const fp64 kStep = static_cast<fp64>(2) / 36;
+  const int kSettleMs = 3000;  // 仿真时长(ms), 点动一步远小于此
+  const int kHoldMs = 500;     // 最后这段时间内输出和位置都不能变
+
+  // 每转一格的量化位置
+  struct QuantizedAxis
+  {
+    fp64 resolution;
+    fp64 pos = 0;
+    fp64 turns = 0;
+
+    void Run(fp32 rpm)
+    {
+      turns += rpm / 60000.0;  // 1ms
+      while (turns >= 1)
+      {
+        pos += resolution;
+        turns -= 1;
+      }
+      while (turns <= -1)
+      {
+        pos -= resolution;
+        turns += 1;
+      }
+    }
+  };
+}  // namespace
+
+// 单线程运行, 不需要真正的时钟和临界区
+extern "C"
+{
+  uint32_t HAL_GetTick(void) { return tick; }
+  void __disable_irq(void) {}
+  void __enable_irq(void) {}
+}
+
+namespace
+{
+  RemoteState Stick(int16_t right_x, int16_t right_y)
+  {
+    RemoteState state = {};
+    state.right_x = right_x;
+    state.right_y = right_y;
+    return state;
+  }
+
+  bool JogSettles(int16_t direction)
+  {
+    TeleopConfig config;
+    QuantizedAxis x{kStep * 7};
+    QuantizedAxis y{kStep * 4};
+    Teleop teleop(config, x.resolution, y.resolution);
+    teleop.Reset();
+
+    // 右摇杆拨出再回中, 两轴各点动一步
+    teleop.OnFrame(Stick(660 * direction, 660 * direction));
+    teleop.OnFrame(Stick(0, 0));
+
+    fp32 x_rpm = 0, y_rpm = 0;
+    fp64 x_hold = 0, y_hold = 0;
+    bool moved = false;
+    for (int ms = 0; ms < kSettleMs; ms++)
+    {
+      tick++;
+      teleop.Update(x.pos, y.pos, &x_rpm, &y_rpm);
+      x.Run(x_rpm);
+      y.Run(y_rpm);
+      if (ms == kSettleMs - kHoldMs)
+      {
+        x_hold = x.pos;
+        y_hold = y.pos;
+      }
+      if (ms > kSettleMs - kHoldMs && (x_rpm != 0 || y_rpm != 0 || x.pos != x_hold || y.pos != y_hold)) moved = true;
+    }
+
+    fp64 x_error = fabs(x.pos - direction * config.jog_step);
+    fp64 y_error = fabs(y.pos - direction * config.jog_step);
+    bool ok = !moved && x_error <= x.resolution && y_error <= y.resolution;
+    printf("%-8s x %+.3f mm, y %+.3f mm, %s\n", direction > 0 ? "jog +1" : "jog -1", x.pos, y.pos,
+           ok ? "settled" : (moved ? "still moving" : "off target"));
+    return ok;
+  }
+}  // namespace
+
+int main()
+{
+  bool ok = JogSettles(1);
+  ok = JogSettles(-1) && ok;
+  return ok ? 0 : 1;
+}
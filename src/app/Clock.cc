@@ -0,0 +1,49 @@
+#include "Clock.h"
+
+#include "main.h"
+
+#if defined(XY_HOST_SIM)
+#include <time.h>
+#endif
+
+#if !defined(XY_HOST_SIM)
+static uint32_t clock_cycles_per_us = 1;  // 每微秒的周期数
+static uint32_t clock_last = 0;           // 已累加到clock_us的CYCCNT位置
+static uint64_t clock_us = 0;             // 启动以来的微秒数
+#endif
+
+/**
+ * @brief 启用DWT周期计数器, 在启动调度器之前调用
+ */
+void ClockInit(void)
+{
+#if !defined(XY_HOST_SIM)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  clock_cycles_per_us = SystemCoreClock / 1000000;
+  clock_last = 0;
+  clock_us = 0;
+#endif
+}
+
+/**
+ * @brief 启动以来的微秒数
+ */
+uint64_t ClockMicros(void)
+{
+#if defined(XY_HOST_SIM)
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#else
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint32_t us = (DWT->CYCCNT - clock_last) / clock_cycles_per_us;
+  clock_last += us * clock_cycles_per_us;  // 不足1us的周期留到下次
+  clock_us += us;
+  uint64_t now = clock_us;
+  __set_PRIMASK(primask);
+  return now;
+#endif
+}
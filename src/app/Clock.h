@@ -0,0 +1,25 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /**
+   * @brief 64位单调微秒时钟
+   * @note  固件由DWT周期计数器扩展而来, 每次读取把上次读取以来的整微秒累加到64位计数,
+   *        只需32位除法; 两次读取的间隔须小于计数器回绕周期(180MHz约23.8s),
+   *        TIM7时基中断每毫秒读取一次保证这一点
+   * @note  任务和中断中均可调用, 可在关中断期间调用(保存并恢复PRIMASK)
+   */
+  void ClockInit(void);
+  uint64_t ClockMicros(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOCK_H */
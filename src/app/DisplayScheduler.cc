@@ -0,0 +1,103 @@
+#include "DisplayScheduler.h"
+
+#include "Clock.h"
+#include "main.h"
+#include "oled.h"
+
+DisplayScheduler display_scheduler;
+
+namespace
+{
+  // 各优先级的最小刷新间隔(ms), 高优先级只受帧率上限限制
+  const uint16_t kPriorityInterval[DISPLAY_PRIORITY_NUM] = {0, DISPLAY_NORMAL_INTERVAL, DISPLAY_LOW_INTERVAL};
+}  // namespace
+
+/**
+ * @brief 设置帧率上限
+ * @param fps 每秒最多发送的帧数, 0按默认值
+ */
+void DisplayScheduler::SetMaxFps(uint8_t fps)
+{
+  if (fps == 0) fps = DISPLAY_MAX_FPS;
+  frame_interval_ = 1000 / fps;
+}
+
+void DisplayScheduler::SetPriority(uint8_t y, uint8_t h, DisplayPriority priority)
+{
+  if (h == 0) return;
+  uint8_t last = (y + h - 1) / 8;
+  for (uint8_t page = y / 8; page <= last && page < 8; page++)
+  {
+    if (!(registered_ & (1 << page)) || priority < priority_[page]) priority_[page] = priority;
+    registered_ |= 1 << page;
+  }
+}
+
+void DisplayScheduler::MarkControlStart()
+{
+  control_start_ = static_cast<uint32_t>(ClockMicros());
+  control_seen_ = true;
+}
+
+/**
+ * @brief 控制线程是否即将开始下一个周期
+ * @note  控制线程每个系统节拍唤醒一次, 按本周期开始时刻推算下一次唤醒;
+ *        刷新线程优先级较低, 能运行时控制线程一定在等待下一个节拍
+ */
+bool DisplayScheduler::NearControlDeadline() const
+{
+  if (!control_seen_) return false;
+  uint32_t elapsed = (static_cast<uint32_t>(ClockMicros()) - control_start_) % DISPLAY_CONTROL_PERIOD;
+  return DISPLAY_CONTROL_PERIOD - elapsed < DISPLAY_CONTROL_GUARD;
+}
+
+/**
+ * @brief 按帧率上限和区域优先级发送到期的页
+ * @note  传输出错后OLED_PendingPages()返回全部页, 由OLED_ShowPages()恢复总线后按优先级重绘
+ */
+void DisplayScheduler::Poll()
+{
+  uint32_t now = HAL_GetTick();
+  if (now - last_frame_ < frame_interval_) return;
+
+  uint8_t pending = OLED_PendingPages();
+  if (!pending) return;
+  if (OLED_IsBusy())
+  {
+    skipped_busy_++;
+    return;
+  }
+
+  uint8_t due = 0;
+  for (uint8_t page = 0; page < 8; page++)
+  {
+    if ((pending & (1 << page)) && now - last_sent_[page] >= kPriorityInterval[priority_[page]]) due |= 1 << page;
+  }
+  if (!due) return;
+
+  // 放在最后检查, 尽量贴近真正发送的时刻
+  if (NearControlDeadline())
+  {
+    skipped_control_++;
+    return;
+  }
+
+  OLED_ShowPages(due);
+  for (uint8_t page = 0; page < 8; page++)
+  {
+    if (due & (1 << page)) last_sent_[page] = now;
+  }
+  last_frame_ = now;
+  frames_++;
+}
+
+/**
+ * @brief 距下一次需要调用Poll()的时间(ms)
+ * @return 没有待发送的页时返回DISPLAY_IDLE
+ */
+uint32_t DisplayScheduler::NextPollDelay() const
+{
+  if (!OLED_PendingPages()) return DISPLAY_IDLE;
+  uint32_t elapsed = HAL_GetTick() - last_frame_;
+  return elapsed < frame_interval_ ? frame_interval_ - elapsed : DISPLAY_RETRY_INTERVAL;
+}
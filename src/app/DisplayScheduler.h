@@ -0,0 +1,73 @@
+#ifndef DISPLAY_SCHEDULER_H
+#define DISPLAY_SCHEDULER_H
+
+#include "OledWidget.h"
+#include "struct_typedef.h"
+
+#define DISPLAY_MAX_FPS 25            // 默认最高帧率, 完整一帧约24ms, 超过30帧总线跟不上
+#define DISPLAY_NORMAL_INTERVAL 100   // 普通区域的最小刷新间隔(ms)
+#define DISPLAY_LOW_INTERVAL 250      // 低优先级区域的最小刷新间隔(ms)
+#define DISPLAY_CONTROL_PERIOD 1000   // 控制周期(us), 控制线程每个系统节拍运行一次
+#define DISPLAY_CONTROL_GUARD 150     // 距下一个控制周期不足该时间(us)时不刷新
+#define DISPLAY_RETRY_INTERVAL 10     // 总线忙或没有到期的页时, 再次检查的间隔(ms)
+#define DISPLAY_IDLE 0xFFFFFFFF       // 没有待发送的页, 等新画面发布后再检查
+
+// 区域优先级, 数值越小越优先
+enum DisplayPriority
+{
+  DISPLAY_PRIORITY_HIGH,    // 每帧都刷新, 如正在走的计时
+  DISPLAY_PRIORITY_NORMAL,  // 未登记区域的默认优先级
+  DISPLAY_PRIORITY_LOW,     // 偶尔变化、晚一点显示也无妨的内容
+  DISPLAY_PRIORITY_NUM
+};
+
+/**
+ * @brief 屏幕刷新调度
+ * @note  刷新线程周期调用Poll(), 按帧率上限决定是否发送一帧, 每帧只发送到期的页:
+ *        高优先级页每帧都发送, 其余页距上次发送超过各自的间隔才发送, 期间的多次发布合并为一次.
+ *        页之间没有依赖, 不到期的页脏区留在驱动中, 不会丢失
+ * @note  静态标签只在整屏重绘时绘制一次, 之后不产生脏区, 不参与调度
+ * @note  总线上一帧未发完、或控制线程即将开始下一个周期时跳过本次, 刷新不占用控制线程的时间;
+ *        控制线程在每个周期开始时调用MarkControlStart()
+ * @note  刷新线程不必周期运行: 按NextPollDelay()休眠, 发布了新画面时被唤醒
+ */
+class DisplayScheduler
+{
+ public:
+  void SetMaxFps(uint8_t fps);
+  // 行[y, y + h)所在的页; 同一页登记了多个区域时取最高的优先级
+  void SetPriority(uint8_t y, uint8_t h, DisplayPriority priority);
+  void SetPriority(const OledWidget &widget, DisplayPriority priority)
+  {
+    SetPriority(widget.y(), widget.h(), priority);
+  }
+
+  void MarkControlStart();  // 控制线程每个周期开始时调用
+  void Poll();              // 刷新线程调用
+  uint32_t NextPollDelay() const;
+
+  uint32_t frames() const { return frames_; }
+  uint32_t skipped_busy() const { return skipped_busy_; }
+  uint32_t skipped_control() const { return skipped_control_; }
+
+ private:
+  bool NearControlDeadline() const;
+
+  uint16_t frame_interval_ = 1000 / DISPLAY_MAX_FPS;  // ms
+  uint8_t priority_[8] = {DISPLAY_PRIORITY_NORMAL, DISPLAY_PRIORITY_NORMAL, DISPLAY_PRIORITY_NORMAL,
+                          DISPLAY_PRIORITY_NORMAL, DISPLAY_PRIORITY_NORMAL, DISPLAY_PRIORITY_NORMAL,
+                          DISPLAY_PRIORITY_NORMAL, DISPLAY_PRIORITY_NORMAL};
+  uint8_t registered_ = 0;               // 已登记过优先级的页
+  uint32_t last_frame_ = 0;              // 上一次发送的时刻(ms)
+  uint32_t last_sent_[8] = {0};          // 各页上一次发送的时刻(ms)
+  volatile uint32_t control_start_ = 0;  // 控制线程本周期开始时刻(us, 低32位)
+  volatile bool control_seen_ = false;   // 控制线程已开始运行
+
+  uint32_t frames_ = 0;
+  uint32_t skipped_busy_ = 0;
+  uint32_t skipped_control_ = 0;
+};
+
+extern DisplayScheduler display_scheduler;
+
+#endif /* DISPLAY_SCHEDULER_H */
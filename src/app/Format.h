@@ -0,0 +1,106 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file Format.h
+ * @brief 整数和定点数格式化, 代替显示路径上的sprintf
+ *
+ * @note
+ * 不分配内存, 不使用全局状态和浮点, 可在中断中调用, 也可在编译期求值.
+ * 结果写入调用者的缓冲区并以'\0'结尾, 返回写入的字符数(不含'\0');
+ * 缓冲区放不下时写入空串并返回0.
+ * width为最小宽度, 不足时在左侧补pad(右对齐), 补'0'时负号在补齐字符之前.
+ */
+
+#define FORMAT_MAX_DECIMALS 9  // 32位数最多10位, 小数位数超过9时按9处理
+
+/**
+ * @brief 格式化一个定点数的绝对值
+ * @param magnitude 绝对值, 按10^decimals缩放
+ * @param negative 是否输出负号
+ * @param decimals 小数位数, 0表示整数, 最多FORMAT_MAX_DECIMALS位
+ */
+constexpr size_t FormatDigits(char *buf, size_t size, uint32_t magnitude, bool negative, uint8_t decimals,
+                              uint8_t width, char pad)
+{
+  // 逆序生成数字, 至少decimals+1位, 保证"0.05"这样的前导零
+  if (decimals > FORMAT_MAX_DECIMALS) decimals = FORMAT_MAX_DECIMALS;
+  char digits[FORMAT_MAX_DECIMALS + 1] = {};
+  uint8_t count = 0;
+  do
+  {
+    digits[count++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0 || count <= decimals);
+
+  size_t len = count + (decimals ? 1 : 0) + (negative ? 1 : 0);
+  size_t total = len < width ? width : len;
+  if (size == 0) return 0;
+  if (total + 1 > size)
+  {
+    buf[0] = '\0';
+    return 0;
+  }
+
+  char *p = buf;
+  if (negative && pad == '0') *p++ = '-';
+  for (size_t i = len; i < total; i++)
+  {
+    *p++ = pad;
+  }
+  if (negative && pad != '0') *p++ = '-';
+  while (count > 0)
+  {
+    if (count == decimals) *p++ = '.';
+    *p++ = digits[--count];
+  }
+  *p = '\0';
+  return total;
+}
+
+/**
+ * @brief 无符号整数, 如FormatUInt(buf, n, 42, 5) -> "   42"
+ */
+constexpr size_t FormatUInt(char *buf, size_t size, uint32_t value, uint8_t width = 0, char pad = ' ')
+{
+  return FormatDigits(buf, size, value, false, 0, width, pad);
+}
+
+/**
+ * @brief 有符号整数, 如FormatInt(buf, n, -7, 3, '0') -> "-07"
+ */
+constexpr size_t FormatInt(char *buf, size_t size, int32_t value, uint8_t width = 0, char pad = ' ')
+{
+  uint32_t magnitude = value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+  return FormatDigits(buf, size, magnitude, value < 0, 0, width, pad);
+}
+
+/**
+ * @brief 定点数, value按10^decimals缩放, 如FormatFixed(buf, n, -1234, 2) -> "-12.34"
+ * @note  decimals超过FORMAT_MAX_DECIMALS时按FORMAT_MAX_DECIMALS处理
+ */
+constexpr size_t FormatFixed(char *buf, size_t size, int32_t value, uint8_t decimals, uint8_t width = 0,
+                             char pad = ' ')
+{
+  uint32_t magnitude = value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+  return FormatDigits(buf, size, magnitude, value < 0, decimals, width, pad);
+}
+
+/**
+ * @brief 毫秒转为秒, 保留decimals(0~3)位小数并截断, 如FormatSeconds(buf, n, 12345, 1) -> "12.3"
+ */
+constexpr size_t FormatSeconds(char *buf, size_t size, uint32_t ms, uint8_t decimals, uint8_t width = 0,
+                               char pad = ' ')
+{
+  uint32_t divisor = 1;
+  for (uint8_t i = decimals; i < 3; i++)
+  {
+    divisor *= 10;
+  }
+  return FormatDigits(buf, size, ms / divisor, false, decimals > 3 ? 3 : decimals, width, pad);
+}
+
+#endif /* FORMAT_H */
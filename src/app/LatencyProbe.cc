@@ -0,0 +1,175 @@
+#include "LatencyProbe.h"
+
+#include <cstdlib>
+#include "Clock.h"
+#include "main.h"
+
+#if !defined(XY_HOST_SIM)
+#include "can.h"
+#endif
+
+LatencyProbe latency_probe;
+
+namespace
+{
+  const uint8_t kBucketsPerFrame = 3;
+  const uint8_t kFramesPerInterval = (LATENCY_BUCKETS + kBucketsPerFrame - 1) / kBucketsPerFrame + 1;
+
+  inline void PutU16(uint8_t *buf, uint16_t value)
+  {
+    buf[0] = static_cast<uint8_t>(value);
+    buf[1] = static_cast<uint8_t>(value >> 8);
+  }
+
+  // 时间戳取64位微秒时钟的低32位, 约71分钟回绕, 只用于计算差值
+  inline uint32_t Now() { return static_cast<uint32_t>(ClockMicros()); }
+
+#if !defined(XY_HOST_SIM)
+  void OnCan1TxComplete(CAN_HandleTypeDef *hcan)
+  {
+    UNUSED(hcan);
+    latency_probe.MarkTxComplete();
+  }
+#endif
+}  // namespace
+
+/**
+ * @brief 挂接CAN1发送完成回调
+ * @note  HAL只允许在CAN处于READY状态时注册回调, 须在can1.Begin()之前调用
+ */
+void LatencyProbe::Init()
+{
+#if !defined(XY_HOST_SIM)
+  HAL_CAN_RegisterCallback(&hcan1, HAL_CAN_TX_MAILBOX0_COMPLETE_CB_ID, OnCan1TxComplete);
+  HAL_CAN_RegisterCallback(&hcan1, HAL_CAN_TX_MAILBOX1_COMPLETE_CB_ID, OnCan1TxComplete);
+  HAL_CAN_RegisterCallback(&hcan1, HAL_CAN_TX_MAILBOX2_COMPLETE_CB_ID, OnCan1TxComplete);
+  HAL_CAN_ActivateNotification(&hcan1, CAN_IT_TX_MAILBOX_EMPTY);
+#endif
+}
+
+void LatencyProbe::Reset()
+{
+  __disable_irq();
+  stage_ = -1;
+  for (int i = 0; i < LATENCY_INTERVAL_NUM; i++)
+  {
+    histograms_[i] = LatencyHistogram{};
+  }
+  timeouts_ = 0;
+  __enable_irq();
+}
+
+void LatencyProbe::Mark(LatencyStage stage)
+{
+  if (stage_ != stage - 1) return;  // 只按顺序记录各阶段
+  stamps_[stage] = Now();
+  stage_ = stage;
+}
+
+void LatencyProbe::MarkInput() { last_input_ = Now(); }
+
+void LatencyProbe::MarkDecoded(int16_t x_rpm, int16_t y_rpm)
+{
+  if (!enabled_) return;
+
+  // 新的切换会覆盖尚未完成的测量
+  stamps_[LATENCY_STAGE_INPUT] = last_input_;
+  stamps_[LATENCY_STAGE_DECODED] = Now();
+  base_x_rpm_ = x_rpm;
+  base_y_rpm_ = y_rpm;
+  stage_ = LATENCY_STAGE_DECODED;
+}
+
+void LatencyProbe::MarkSetpoint() { Mark(LATENCY_STAGE_SETPOINT); }
+
+void LatencyProbe::MarkQueued()
+{
+  Mark(LATENCY_STAGE_QUEUED);
+#if defined(XY_HOST_SIM)
+  // SocketCAN写入即交给内核, 不区分发送完成
+  Mark(LATENCY_STAGE_TX_COMPLETE);
+#endif
+}
+
+void LatencyProbe::MarkTxComplete() { Mark(LATENCY_STAGE_TX_COMPLETE); }
+
+void LatencyProbe::MarkFeedback(int16_t x_rpm, int16_t y_rpm)
+{
+  if (stage_ < LATENCY_STAGE_DECODED) return;
+
+  if (Now() - stamps_[LATENCY_STAGE_DECODED] > LATENCY_TIMEOUT_US)
+  {
+    stage_ = -1;
+    timeouts_++;
+    return;
+  }
+
+  if (stage_ != LATENCY_STAGE_TX_COMPLETE) return;
+  if (abs(x_rpm - base_x_rpm_) < LATENCY_MOTION_RPM && abs(y_rpm - base_y_rpm_) < LATENCY_MOTION_RPM) return;
+
+  Mark(LATENCY_STAGE_MOTION);
+  Finish();
+}
+
+void LatencyProbe::Finish()
+{
+  for (int i = 0; i < LATENCY_INTERVAL_TOTAL; i++)
+  {
+    Record(i, stamps_[i + 1] - stamps_[i]);
+  }
+  Record(LATENCY_INTERVAL_TOTAL, stamps_[LATENCY_STAGE_MOTION] - stamps_[LATENCY_STAGE_INPUT]);
+  stage_ = -1;
+}
+
+void LatencyProbe::Record(int interval, uint32_t us)
+{
+  LatencyHistogram &h = histograms_[interval];
+
+  uint8_t bucket = 0;
+  while (bucket < LATENCY_BUCKETS - 1 && (us >> (bucket + 1)) != 0)
+  {
+    bucket++;
+  }
+
+  if (h.buckets[bucket] < 0xFFFF) h.buckets[bucket]++;
+  if (h.count == 0 || us < h.min_us) h.min_us = us;
+  if (us > h.max_us) h.max_us = us;
+  if (h.count < 0xFFFF) h.count++;
+  h.sum_us += us;
+}
+
+/**
+ * @brief 每次调用发送一帧直方图数据, 避免一次占满CAN2
+ */
+void LatencyProbe::DumpStep(rm::hal::CanInterface &can)
+{
+  if (dump_index_ < 0) return;
+
+  uint8_t interval = dump_index_ / kFramesPerInterval;
+  uint8_t frame = dump_index_ % kFramesPerInterval;
+  const LatencyHistogram &h = histograms_[interval];
+  uint8_t buf[8] = {0};
+
+  buf[0] = interval;
+  if (frame + 1 < kFramesPerInterval)
+  {
+    uint8_t first = frame * kBucketsPerFrame;
+    buf[1] = first;
+    for (uint8_t i = 0; i < kBucketsPerFrame && first + i < LATENCY_BUCKETS; i++)
+    {
+      PutU16(&buf[2 + i * 2], h.buckets[first + i]);
+    }
+    can.Write(LATENCY_ID_HISTOGRAM, buf, sizeof(buf));
+  }
+  else
+  {
+    buf[1] = timeouts_ > 0xFF ? 0xFF : timeouts_;
+    PutU16(&buf[2], h.count);
+    PutU16(&buf[4], static_cast<uint16_t>(h.max_us));
+    PutU16(&buf[6], static_cast<uint16_t>(h.max_us >> 16));
+    can.Write(LATENCY_ID_SUMMARY, buf, sizeof(buf));
+  }
+
+  dump_index_++;
+  if (dump_index_ >= LATENCY_INTERVAL_NUM * kFramesPerInterval) dump_index_ = -1;
+}
@@ -0,0 +1,97 @@
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include "librm.hpp"
+#include "struct_typedef.h"
+
+// CAN2延迟统计帧ID
+#define LATENCY_ID_HISTOGRAM 0x308  // [0]区间 [1]起始桶 [2:7]3个桶计数(uint16)
+#define LATENCY_ID_SUMMARY 0x309    // [0]区间 [1]超时次数 [2:3]样本数 [4:7]最大值(us)
+
+#define LATENCY_BUCKETS 16          // 对数桶: 桶i统计[2^i, 2^(i+1))us, 桶0含0~1us
+#define LATENCY_TIMEOUT_US 3000000  // 3s内未见运动视为超时
+#define LATENCY_MOTION_RPM 200      // 转速变化超过该值视为开始运动
+
+// 测量阶段
+enum LatencyStage
+{
+  LATENCY_STAGE_INPUT,        // 收到输入帧(遥控器/遥测命令)
+  LATENCY_STAGE_DECODED,      // 等级切换被识别
+  LATENCY_STAGE_SETPOINT,     // 生成电流指令(SetCurrent)
+  LATENCY_STAGE_QUEUED,       // CAN指令进入发送邮箱
+  LATENCY_STAGE_TX_COMPLETE,  // CAN发送完成
+  LATENCY_STAGE_MOTION,       // 反馈帧首次显示运动
+  LATENCY_STAGE_NUM
+};
+
+// 统计区间: 相邻阶段之间, 以及输入到运动的总延迟
+#define LATENCY_INTERVAL_TOTAL (LATENCY_STAGE_NUM - 1)
+#define LATENCY_INTERVAL_NUM LATENCY_STAGE_NUM
+
+// 遥测命令参数(TELEMETRY_CMD_LATENCY)
+enum LatencyCommand
+{
+  LATENCY_CMD_DISABLE = 0,
+  LATENCY_CMD_ENABLE = 1,
+  LATENCY_CMD_DUMP = 2,
+  LATENCY_CMD_RESET = 3,
+};
+
+struct LatencyHistogram
+{
+  uint16_t buckets[LATENCY_BUCKETS];
+  uint16_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+};
+
+/**
+ * @brief 指令到运动的延迟测量
+ * @note  每次切换到非零等级时开始一次测量, 依次记录各阶段时间戳,
+ *        运动出现后把各区间耗时计入直方图. 直方图可通过CAN2按需导出
+ * @note  Mark*函数可在中断中调用
+ */
+class LatencyProbe
+{
+ public:
+  void Init();
+
+  void SetEnabled(bool enabled) { enabled_ = enabled; }
+  bool enabled() const { return enabled_; }
+  void Reset();
+
+  void MarkInput();                                 // 输入帧到达
+  void MarkDecoded(int16_t x_rpm, int16_t y_rpm);   // 识别到等级切换, 开始一次测量
+  void MarkSetpoint();                              // 生成电流指令
+  void MarkQueued();                                // SendCommand之后
+  void MarkTxComplete();                            // CAN1发送完成中断
+  void MarkFeedback(int16_t x_rpm, int16_t y_rpm);  // 控制循环读取反馈后
+
+  // 开始导出直方图, 之后每次调用DumpStep发送一帧
+  void StartDump() { dump_index_ = 0; }
+  void DumpStep(rm::hal::CanInterface &can);
+
+  const LatencyHistogram &histogram(int interval) const { return histograms_[interval]; }
+  uint16_t timeouts() const { return timeouts_; }
+
+ private:
+  void Mark(LatencyStage stage);
+  void Finish();
+  void Record(int interval, uint32_t us);
+
+  volatile bool enabled_ = false;
+  volatile int8_t stage_ = -1;  // 已到达的阶段, -1表示未在测量
+  volatile uint32_t stamps_[LATENCY_STAGE_NUM] = {0};
+  volatile uint32_t last_input_ = 0;
+  int16_t base_x_rpm_ = 0;  // 测量开始时的转速, 用于判断运动
+  int16_t base_y_rpm_ = 0;
+
+  LatencyHistogram histograms_[LATENCY_INTERVAL_NUM] = {};
+  uint16_t timeouts_ = 0;
+  int16_t dump_index_ = -1;
+};
+
+extern LatencyProbe latency_probe;
+
+#endif /* LATENCY_PROBE_H */
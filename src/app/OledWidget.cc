@@ -0,0 +1,156 @@
+#include "OledWidget.h"
+
+#include <cstring>
+
+#include "Format.h"
+
+/**
+ * @brief 清空控件内从横坐标from开始到右边界的部分
+ */
+void OledWidget::Clear(uint8_t from)
+{
+  uint8_t end = x_ + w_;
+  if (from >= end) return;
+  OLED_DrawFilledRectangle(from, y_, end - from - 1, h_, OLED_COLOR_REVERSED);
+}
+
+void OledLabel::Set(const char *text)
+{
+  if (drawn_ && strncmp(text, text_, OLED_WIDGET_TEXT_MAX) == 0) return;
+  strncpy(text_, text, OLED_WIDGET_TEXT_MAX);
+  text_[OLED_WIDGET_TEXT_MAX] = '\0';
+  drawn_ = true;
+
+  // 逐字符覆盖, 超出控件宽度的字符不绘制
+  uint8_t x = x_;
+  for (const char *c = text_; *c && x + font_->w <= x_ + w_; c++, x += font_->w)
+  {
+    OLED_PrintASCIIChar(x, y_, *c, font_, OLED_COLOR_NORMAL);
+  }
+  Clear(x);
+}
+
+void OledNumber::Set(uint32_t value)
+{
+  if (showing_value_ && value == value_) return;
+  value_ = value;
+  showing_value_ = true;
+
+  char text[12];
+  FormatUInt(text, sizeof(text), value);
+  OledLabel::Set(text);
+}
+
+void OledNumber::SetText(const char *text)
+{
+  showing_value_ = false;
+  OledLabel::Set(text);
+}
+
+void OledNumber::Invalidate()
+{
+  showing_value_ = false;
+  OledLabel::Invalidate();
+}
+
+void OledBar::Set(uint32_t value, uint32_t max)
+{
+  if (w_ < 3 || h_ < 3) return;
+  uint8_t inner = w_ - 2;
+  if (value > max) value = max;
+  uint8_t fill = max ? static_cast<uint8_t>(static_cast<uint32_t>(inner) * value / max) : 0;
+  if (drawn_ && fill == fill_) return;
+
+  if (!drawn_)
+  {
+    OLED_DrawRectangle(x_, y_, w_ - 1, h_ - 1, OLED_COLOR_NORMAL);
+    drawn_ = true;
+    fill_ = 0;
+    OLED_DrawFilledRectangle(x_ + 1, y_ + 1, inner - 1, h_ - 2, OLED_COLOR_REVERSED);
+  }
+
+  // 只重绘填充宽度变化的部分
+  if (fill > fill_)
+  {
+    OLED_DrawFilledRectangle(x_ + 1 + fill_, y_ + 1, fill - fill_ - 1, h_ - 2, OLED_COLOR_NORMAL);
+  }
+  else if (fill < fill_)
+  {
+    OLED_DrawFilledRectangle(x_ + 1 + fill, y_ + 1, fill_ - fill - 1, h_ - 2, OLED_COLOR_REVERSED);
+  }
+  fill_ = fill;
+}
+
+void OledIcon::Set(bool visible)
+{
+  if (drawn_ && visible == visible_) return;
+  visible_ = visible;
+  drawn_ = true;
+
+  if (visible)
+  {
+    OLED_DrawImage(x_, y_, image_, OLED_COLOR_NORMAL);
+  }
+  else
+  {
+    Clear(x_);
+  }
+}
+
+uint8_t OledPlot::Row(int32_t value) const
+{
+  if (value <= min_) return h_ - 1;
+  if (value >= max_) return 0;
+  uint32_t offset = static_cast<uint32_t>(value - min_);
+  uint32_t range = static_cast<uint32_t>(max_ - min_);
+  return static_cast<uint8_t>(h_ - 1 - offset * (h_ - 1) / range);
+}
+
+void OledPlot::Push(int32_t target, int32_t actual)
+{
+  uint8_t row = Row(actual);
+  if (samples_ == 0)
+  {
+    current_.low = last_actual_;
+    current_.high = last_actual_;
+  }
+  if (row < current_.low) current_.low = row;
+  if (row > current_.high) current_.high = row;
+  last_actual_ = row;
+  if (++samples_ < decimation_) return;
+
+  current_.target = Row(target);
+  samples_ = 0;
+  uint8_t next = (head_ + 1) % OLED_PLOT_RING;
+  if (next == tail_) return;  // 长时间未绘制, 丢弃新列
+  ring_[head_] = current_;
+  head_ = next;
+}
+
+void OledPlot::Draw()
+{
+  if (!drawn_)
+  {
+    OLED_DrawFilledRectangle(x_, y_, w_ - 1, h_, OLED_COLOR_REVERSED);
+    drawn_ = true;
+  }
+
+  uint8_t n = (head_ + OLED_PLOT_RING - tail_) % OLED_PLOT_RING;
+  if (n == 0) return;
+  if (n > w_)
+  {
+    tail_ = (head_ + OLED_PLOT_RING - w_) % OLED_PLOT_RING;
+    n = w_;
+  }
+
+  // 已有内容左移n列, 新列画在右端
+  OLED_ScrollLeft(x_, y_, w_, h_, n);
+  for (uint8_t i = 0; i < n; i++)
+  {
+    const Column &column = ring_[(tail_ + i) % OLED_PLOT_RING];
+    uint8_t x = x_ + w_ - n + i;
+    OLED_DrawVLine(x, y_ + column.low, column.high - column.low + 1, OLED_COLOR_NORMAL);
+    OLED_SetPixel(x, y_ + column.target, OLED_COLOR_NORMAL);
+  }
+  tail_ = head_;
+}
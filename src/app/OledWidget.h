@@ -0,0 +1,143 @@
+#ifndef OLED_WIDGET_H
+#define OLED_WIDGET_H
+
+#include "oled.h"
+#include "struct_typedef.h"
+
+#define OLED_WIDGET_TEXT_MAX 16  // 文本控件缓存的最大字符数
+#define OLED_PLOT_RING 32        // 曲线控件两次绘制之间最多缓存的列数
+
+/**
+ * @brief 保留模式的OLED控件
+ * @note  控件记住上一次绘制的内容, Set*()的值没有变化时直接返回, 不做格式化和光栅化,
+ *        每个控制周期都调用也几乎没有开销; 内容变化时只重绘控件自身区域
+ * @note  控件只写绘制缓冲区, 由调用者OLED_Publish()发布
+ */
+class OledWidget
+{
+ public:
+  OledWidget(uint8_t x, uint8_t y, uint8_t w, uint8_t h) : x_(x), y_(y), w_(w), h_(h) {}
+
+  // 下一次Set*()无论值是否变化都重绘, 用于整屏清空之后
+  void Invalidate() { drawn_ = false; }
+
+  uint8_t y() const { return y_; }
+  uint8_t h() const { return h_; }
+
+ protected:
+  void Clear(uint8_t from);  // 清空控件内从横坐标from开始的部分
+
+  uint8_t x_;
+  uint8_t y_;
+  uint8_t w_;
+  uint8_t h_;
+  bool drawn_ = false;
+};
+
+/**
+ * @brief 文本标签
+ * @note  文本左对齐, 文本之后到控件右边界的部分清空
+ */
+class OledLabel : public OledWidget
+{
+ public:
+  OledLabel(uint8_t x, uint8_t y, uint8_t w, const ASCIIFont *font) : OledWidget(x, y, w, font->h), font_(font) {}
+
+  void Set(const char *text);
+
+ private:
+  const ASCIIFont *font_;
+  char text_[OLED_WIDGET_TEXT_MAX + 1] = {0};
+};
+
+/**
+ * @brief 数值显示框
+ * @note  显示无符号整数, 也可以临时显示一段状态文本(如"OVERTIME");
+ *        数值不变时不重新格式化
+ */
+class OledNumber : public OledLabel
+{
+ public:
+  OledNumber(uint8_t x, uint8_t y, uint8_t w, const ASCIIFont *font) : OledLabel(x, y, w, font) {}
+
+  void Set(uint32_t value);
+  void SetText(const char *text);
+  void Invalidate();
+
+ private:
+  uint32_t value_ = 0;
+  bool showing_value_ = false;  // 当前显示的是value_而不是文本
+};
+
+/**
+ * @brief 进度条
+ * @note  带1像素边框, 内部按value/max填充
+ */
+class OledBar : public OledWidget
+{
+ public:
+  OledBar(uint8_t x, uint8_t y, uint8_t w, uint8_t h) : OledWidget(x, y, w, h) {}
+
+  void Set(uint32_t value, uint32_t max);
+
+ private:
+  uint8_t fill_ = 0;  // 已绘制的填充宽度(像素)
+};
+
+/**
+ * @brief 图标
+ */
+class OledIcon : public OledWidget
+{
+ public:
+  OledIcon(uint8_t x, uint8_t y, const Image *image) : OledWidget(x, y, image->w, image->h), image_(image) {}
+
+  void Set(bool visible);
+
+ private:
+  const Image *image_;
+  bool visible_ = false;
+};
+
+/**
+ * @brief 滚动曲线(示波器式条带图)
+ * @note  控制循环每周期Push()一个采样, 每decimation个采样合成一列: 目标值取最后一个采样画点,
+ *        实际值画出该列采样的最小~最大值并与上一列相连(峰值检测, 短时过冲不会因抽样而丢失)
+ * @note  Draw()用OLED_ScrollLeft()把已有内容左移, 只光栅化新增的列;
+ *        Push()和Draw()在同一线程中调用, 两次Draw()之间超过OLED_PLOT_RING列时丢弃新列
+ * @note  取值范围max - min需小于2^25, 超出范围的值画在边界上
+ */
+class OledPlot : public OledWidget
+{
+ public:
+  OledPlot(uint8_t x, uint8_t y, uint8_t w, uint8_t h, int32_t min, int32_t max, uint8_t decimation)
+      : OledWidget(x, y, w, h), min_(min), max_(max), decimation_(decimation ? decimation : 1)
+  {
+  }
+
+  void Push(int32_t target, int32_t actual);
+  void Draw();
+
+ private:
+  // 一列的行号(相对控件顶部)
+  struct Column
+  {
+    uint8_t target;
+    uint8_t low;
+    uint8_t high;
+  };
+
+  uint8_t Row(int32_t value) const;
+
+  int32_t min_;
+  int32_t max_;
+  uint8_t decimation_;
+  uint8_t samples_ = 0;      // 当前列已累计的采样数
+  uint8_t last_actual_ = 0;  // 上一个实际值采样的行号, 新列从这里连线
+  Column current_ = {0, 0, 0};
+  Column ring_[OLED_PLOT_RING];
+  uint8_t head_ = 0;  // 下一个完成列的写入位置
+  uint8_t tail_ = 0;  // 下一个待绘制列
+};
+
+#endif /* OLED_WIDGET_H */
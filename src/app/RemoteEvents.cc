@@ -0,0 +1,76 @@
+#include "RemoteEvents.h"
+
+#include <cstdlib>
+
+RemoteEvents remote_events;
+
+void RemoteEvents::Process(const RemoteState &state)
+{
+  FilterSwitch(switch_l_, static_cast<uint8_t>(state.switch_l), REMOTE_EVENT_SWITCH_L, state.timestamp);
+  FilterSwitch(switch_r_, static_cast<uint8_t>(state.switch_r), REMOTE_EVENT_SWITCH_R, state.timestamp);
+
+  // 拨轮和摇杆带回差, 阈值附近抖动不会反复触发
+  bool dial_active = dial_active_ ? state.dial > REMOTE_DIAL_OFF : state.dial > REMOTE_DIAL_ON;
+  if (dial_active != dial_active_ && Push(REMOTE_EVENT_DIAL, dial_active_, dial_active, state.timestamp))
+  {
+    dial_active_ = dial_active;
+  }
+
+  int16_t stick = abs(state.left_x) > abs(state.left_y) ? abs(state.left_x) : abs(state.left_y);
+  bool stick_active = stick_active_ ? stick > REMOTE_STICK_IDLE : stick > REMOTE_STICK_ACTIVE;
+  if (stick_active != stick_active_ && Push(REMOTE_EVENT_STICK, stick_active_, stick_active, state.timestamp))
+  {
+    stick_active_ = stick_active;
+  }
+}
+
+/**
+ * @brief 拨杆消抖, 同一挡位连续出现REMOTE_SWITCH_DEBOUNCE帧后才确认
+ */
+void RemoteEvents::FilterSwitch(SwitchFilter &filter, uint8_t value, RemoteEventType type, uint32_t timestamp)
+{
+  if (value == filter.stable)
+  {
+    filter.count = 0;
+    return;
+  }
+
+  if (value != filter.candidate)
+  {
+    filter.candidate = value;
+    filter.count = 0;
+  }
+
+  // 队列满时保持计数, 下一帧再次尝试
+  if (++filter.count >= REMOTE_SWITCH_DEBOUNCE && Push(type, filter.stable, value, timestamp))
+  {
+    filter.stable = value;
+    filter.count = 0;
+  }
+}
+
+/**
+ * @return 队列满时返回false
+ */
+bool RemoteEvents::Push(RemoteEventType type, uint8_t from, uint8_t to, uint32_t timestamp)
+{
+  uint8_t next = (head_ + 1) & (REMOTE_EVENT_QUEUE_SIZE - 1);
+  if (next == tail_)
+  {
+    dropped_++;
+    return false;
+  }
+
+  queue_[head_] = RemoteEvent{static_cast<uint8_t>(type), from, to, timestamp};
+  head_ = next;
+  return true;
+}
+
+bool RemoteEvents::Poll(RemoteEvent *event)
+{
+  if (tail_ == head_) return false;
+
+  *event = queue_[tail_];
+  tail_ = (tail_ + 1) & (REMOTE_EVENT_QUEUE_SIZE - 1);
+  return true;
+}
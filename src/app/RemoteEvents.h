@@ -0,0 +1,74 @@
+#ifndef REMOTE_EVENTS_H
+#define REMOTE_EVENTS_H
+
+#include "RemoteReceiver.h"
+
+#define REMOTE_EVENT_QUEUE_SIZE 16   // 事件队列长度(2的幂)
+#define REMOTE_SWITCH_DEBOUNCE 2     // 拨杆连续相同帧数才确认, 约28ms
+#define REMOTE_DIAL_ON 500           // 拨轮超过该值进入手控
+#define REMOTE_DIAL_OFF 400          // 拨轮低于该值退出手控(回差)
+#define REMOTE_STICK_ACTIVE 30       // 摇杆超过该值视为操作中
+#define REMOTE_STICK_IDLE 20         // 摇杆低于该值视为回中(回差)
+
+// 输入事件类型
+enum RemoteEventType
+{
+  REMOTE_EVENT_SWITCH_L,  // 左拨杆换挡, from/to为RcSwitchState
+  REMOTE_EVENT_SWITCH_R,  // 右拨杆换挡
+  REMOTE_EVENT_DIAL,      // 拨轮越过阈值, to=1进入手控 to=0退出
+  REMOTE_EVENT_STICK,     // 左摇杆, to=1开始操作 to=0回中
+};
+
+struct RemoteEvent
+{
+  uint8_t type;        // RemoteEventType
+  uint8_t from;        // 原状态
+  uint8_t to;          // 新状态
+  uint32_t timestamp;  // 触发该事件的帧的接收时间(ms)
+};
+
+/**
+ * @brief 遥控器输入事件
+ * @note  接收中断中对每个有效帧做消抖和回差比较, 只在状态确实改变时产生一次事件,
+ *        控制线程从队列中取出处理, 不再每个周期重新判断拨杆
+ * @note  单生产者(接收中断)单消费者(控制线程)队列, 满时丢弃新事件并计数;
+ *        丢弃时不更新已确认的状态, 下一帧重新产生该事件, 控制线程不会停在旧状态
+ */
+class RemoteEvents
+{
+ public:
+  // 接收中断调用, 根据新帧产生事件
+  void Process(const RemoteState &state);
+
+  // 控制线程调用, 取出一个事件, 队列为空时返回false
+  bool Poll(RemoteEvent *event);
+
+  uint32_t dropped() const { return dropped_; }
+
+ private:
+  struct SwitchFilter
+  {
+    uint8_t stable;     // 已确认的挡位
+    uint8_t candidate;  // 待确认的挡位
+    uint8_t count;      // 候选挡位连续出现的帧数
+  };
+
+  void FilterSwitch(SwitchFilter &filter, uint8_t value, RemoteEventType type, uint32_t timestamp);
+  bool Push(RemoteEventType type, uint8_t from, uint8_t to, uint32_t timestamp);
+
+  static const uint8_t kSwitchUnknown = static_cast<uint8_t>(rm::device::RcSwitchState::kUnknown);
+
+  SwitchFilter switch_l_ = {kSwitchUnknown, kSwitchUnknown, 0};
+  SwitchFilter switch_r_ = {kSwitchUnknown, kSwitchUnknown, 0};
+  bool dial_active_ = false;
+  bool stick_active_ = false;
+
+  RemoteEvent queue_[REMOTE_EVENT_QUEUE_SIZE];
+  volatile uint8_t head_ = 0;  // 生产者写入位置
+  volatile uint8_t tail_ = 0;  // 消费者读取位置
+  volatile uint32_t dropped_ = 0;
+};
+
+extern RemoteEvents remote_events;
+
+#endif /* REMOTE_EVENTS_H */
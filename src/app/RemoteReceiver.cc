@@ -0,0 +1,207 @@
+#include "RemoteReceiver.h"
+
+#include "LatencyProbe.h"
+#include "RemoteEvents.h"
+
+RemoteReceiver remote_receiver(&huart1);
+
+namespace
+{
+  using rm::device::RcSwitchState;
+
+  // 拨杆编码: 1上 3中 2下
+  inline RcSwitchState ToSwitchState(uint8_t value)
+  {
+    switch (value)
+    {
+      case 1:
+        return RcSwitchState::kUp;
+      case 3:
+        return RcSwitchState::kMid;
+      case 2:
+        return RcSwitchState::kDown;
+      default:
+        return RcSwitchState::kUnknown;
+    }
+  }
+
+  inline bool ChannelValid(uint16_t ch) { return ch >= REMOTE_CH_MIN && ch <= REMOTE_CH_MAX; }
+}  // namespace
+
+void RemoteReceiver::Begin()
+{
+#if !defined(XY_HOST_SIM)
+  HAL_UART_RegisterRxEventCallback(huart_, RxEventCallback);
+  HAL_UART_RegisterCallback(huart_, HAL_UART_ERROR_CB_ID, ErrorCallback);
+  Restart();
+#endif
+}
+
+/**
+ * @brief 从头重新开始接收, 下一帧写入缓冲区起始位置
+ */
+void RemoteReceiver::Restart()
+{
+#if !defined(XY_HOST_SIM)
+  HAL_UART_AbortReceive(huart_);
+  last_pos_ = 0;
+  HAL_UARTEx_ReceiveToIdle_DMA(huart_, dma_buf_, REMOTE_DMA_BUF_SIZE);
+#endif
+}
+
+#if !defined(XY_HOST_SIM)
+void RemoteReceiver::RxEventCallback(UART_HandleTypeDef *huart, uint16_t size)
+{
+  if (huart == remote_receiver.huart_) remote_receiver.OnRxEvent(size);
+}
+
+void RemoteReceiver::ErrorCallback(UART_HandleTypeDef *huart)
+{
+  if (huart != remote_receiver.huart_) return;
+  remote_receiver.errors_++;
+  remote_receiver.Restart();
+}
+#endif
+
+/**
+ * @brief DMA事件(中断上下文)
+ * @param size 当前DMA写入位置, 半传输时为18, 传输完成时为36, IDLE时为实际位置
+ */
+void RemoteReceiver::OnRxEvent(uint16_t size)
+{
+  uint16_t pos = size % REMOTE_DMA_BUF_SIZE;
+
+  // 半传输/传输完成与随后的IDLE落在同一边界, 只处理一次
+  if (pos == last_pos_) return;
+
+  if (pos % REMOTE_FRAME_SIZE != 0)
+  {
+    resyncs_++;
+    Restart();
+    return;
+  }
+
+  // 已写完的一半: 位置18对应前半, 位置0(回绕)对应后半
+  Feed(&dma_buf_[pos == 0 ? REMOTE_FRAME_SIZE : 0]);
+  last_pos_ = pos;
+}
+
+/**
+ * @brief 解码一帧并发布快照
+ */
+void RemoteReceiver::Feed(const uint8_t *frame)
+{
+  uint16_t ch0 = (frame[0] | (frame[1] << 8)) & 0x07FF;
+  uint16_t ch1 = ((frame[1] >> 3) | (frame[2] << 5)) & 0x07FF;
+  uint16_t ch2 = ((frame[2] >> 6) | (frame[3] << 2) | (frame[4] << 10)) & 0x07FF;
+  uint16_t ch3 = ((frame[4] >> 1) | (frame[5] << 7)) & 0x07FF;
+  uint16_t ch4 = (frame[16] | (frame[17] << 8)) & 0x07FF;
+  RcSwitchState switch_r = ToSwitchState((frame[5] >> 4) & 0x03);
+  RcSwitchState switch_l = ToSwitchState((frame[5] >> 6) & 0x03);
+
+  if (!ChannelValid(ch0) || !ChannelValid(ch1) || !ChannelValid(ch2) || !ChannelValid(ch3) || !ChannelValid(ch4) ||
+      switch_r == RcSwitchState::kUnknown || switch_l == RcSwitchState::kUnknown)
+  {
+    errors_++;
+    return;
+  }
+
+  latency_probe.MarkInput();
+
+  RemoteState next;
+  next.right_x = ch0 - REMOTE_CH_OFFSET;
+  next.right_y = ch1 - REMOTE_CH_OFFSET;
+  next.left_x = ch2 - REMOTE_CH_OFFSET;
+  next.left_y = ch3 - REMOTE_CH_OFFSET;
+  next.dial = ch4 - REMOTE_CH_OFFSET;
+  next.switch_l = switch_l;
+  next.switch_r = switch_r;
+  next.timestamp = HAL_GetTick();
+  next.seq = ++frames_;
+
+  __disable_irq();
+  uint32_t gap = next.timestamp - state_.timestamp;
+  if (state_.seq != 0 && gap > window_max_gap_) window_max_gap_ = gap;
+  state_ = next;
+  __enable_irq();
+
+  remote_events.Process(next);
+  if (frame_callback_ != nullptr) frame_callback_(next);
+}
+
+void RemoteReceiver::Snapshot(RemoteState *state) const
+{
+  __disable_irq();
+  *state = state_;
+  __enable_irq();
+}
+
+/**
+ * @brief 更新链路状态
+ * @return 当前链路状态
+ */
+RemoteLink RemoteReceiver::UpdateLink()
+{
+  uint32_t now = HAL_GetTick();
+
+  __disable_irq();
+  uint32_t seq = state_.seq;
+  uint32_t timestamp = state_.timestamp;
+  __enable_irq();
+
+  bool timeout = now - timestamp > REMOTE_LOSS_TIMEOUT;
+  switch (link_)
+  {
+    case REMOTE_LINK_NONE:
+      if (seq != 0 && !timeout) link_ = REMOTE_LINK_OK;
+      break;
+
+    case REMOTE_LINK_OK:
+      if (timeout)
+      {
+        link_ = REMOTE_LINK_LOST;
+        lost_frames_ = seq;
+        losses_++;
+      }
+      break;
+
+    case REMOTE_LINK_LOST:
+      // 偶尔收到一帧不算恢复, 需连续收到若干帧
+      if (timeout)
+      {
+        lost_frames_ = seq;
+      }
+      else if (seq - lost_frames_ >= REMOTE_RECOVER_FRAMES)
+      {
+        link_ = REMOTE_LINK_OK;
+      }
+      break;
+  }
+
+  if (now - window_start_ >= REMOTE_STATS_WINDOW)
+  {
+    uint32_t elapsed = now - window_start_;
+    uint32_t max_gap = window_max_gap_;
+    window_max_gap_ = 0;
+
+    // 失联时尚未结束的间隔也计入
+    if (seq != 0 && now - timestamp > max_gap) max_gap = now - timestamp;
+
+    rate_ = (seq - window_frames_) * 1000 / elapsed;
+    max_gap_ = max_gap > 0xFFFF ? 0xFFFF : max_gap;
+    window_frames_ = seq;
+    window_start_ = now;
+  }
+
+  return link_;
+}
+
+void RemoteReceiver::LinkStats(RemoteLinkStats *stats) const
+{
+  stats->link = link_;
+  stats->rate = rate_;
+  stats->max_gap = max_gap_;
+  stats->losses = losses_;
+  stats->errors = errors_;
+  stats->resyncs = resyncs_;
+}
@@ -0,0 +1,121 @@
+#ifndef REMOTE_RECEIVER_H
+#define REMOTE_RECEIVER_H
+
+#include "librm.hpp"
+#include "struct_typedef.h"
+#include "usart.h"
+
+#define REMOTE_FRAME_SIZE 18                        // DR16每帧18字节, 约14ms一帧
+#define REMOTE_DMA_BUF_SIZE (REMOTE_FRAME_SIZE * 2)  // 环形DMA缓冲区, 前后两半交替接收
+
+#define REMOTE_CH_OFFSET 1024  // 通道中值
+#define REMOTE_CH_MIN 364      // 通道有效范围
+#define REMOTE_CH_MAX 1684
+
+#define REMOTE_LOSS_TIMEOUT 100   // 超过该时间(ms)没有有效帧视为失联, 约7帧
+#define REMOTE_RECOVER_FRAMES 5   // 失联后连续收到该数量的有效帧才恢复
+#define REMOTE_STATS_WINDOW 1000  // 帧率/最大间隔统计窗口(ms)
+
+// 遥控器链路状态
+enum RemoteLink
+{
+  REMOTE_LINK_NONE,  // 上电后尚未收到有效帧
+  REMOTE_LINK_OK,
+  REMOTE_LINK_LOST,  // 失联, 控制线程进入失控保护
+};
+
+// 链路统计
+struct RemoteLinkStats
+{
+  uint8_t link;      // RemoteLink
+  uint16_t rate;     // 上一统计窗口的有效帧率(帧/s)
+  uint16_t max_gap;  // 上一统计窗口内最大帧间隔(ms)
+  uint32_t losses;   // 失联次数
+  uint32_t errors;   // 无效帧和串口错误次数
+  uint32_t resyncs;  // 帧错位重启次数
+};
+
+/**
+ * @brief 遥控器状态快照
+ */
+struct RemoteState
+{
+  int16_t right_x;  // 各通道 -660~660
+  int16_t right_y;
+  int16_t left_x;
+  int16_t left_y;
+  int16_t dial;
+  rm::device::RcSwitchState switch_l;
+  rm::device::RcSwitchState switch_r;
+  uint32_t timestamp;  // 收到该帧的时间(ms)
+  uint32_t seq;        // 有效帧序号, 0表示尚未收到
+};
+
+// 有效帧回调, 在接收中断中调用
+typedef void (*RemoteFrameCallback)(const RemoteState &state);
+
+/**
+ * @brief DR16接收机
+ * @note  USART1以环形DMA连续接收, 由半传输/传输完成/IDLE事件给出帧边界,
+ *        直接在DMA缓冲区中已写完的一半上解码, 不做额外拷贝
+ * @note  帧边界不在半区边界上说明字节流错位, 立即重启DMA使下一帧重新对齐
+ * @note  解码后的快照在临界区内整体更新, 控制线程通过Snapshot取得一致的状态;
+ *        同时交给RemoteEvents生成拨杆/拨轮/摇杆事件
+ * @note  UpdateLink根据帧间隔判断失联, 无效帧不刷新时间戳, 持续的乱码同样会被判为失联
+ */
+class RemoteReceiver
+{
+ public:
+  explicit RemoteReceiver(UART_HandleTypeDef *huart) : huart_(huart) {}
+
+  void Begin();
+
+  // 取得最新状态快照
+  void Snapshot(RemoteState *state) const;
+
+  // 输入一整帧(主机仿真用, 固件由DMA事件调用)
+  void Feed(const uint8_t *frame);
+
+  // 注册有效帧回调, 用于需要按帧立即响应的模块
+  void AttachFrameCallback(RemoteFrameCallback callback) { frame_callback_ = callback; }
+
+  // 控制线程周期调用, 更新链路状态和统计窗口
+  RemoteLink UpdateLink();
+  void LinkStats(RemoteLinkStats *stats) const;
+
+  uint32_t frames() const { return frames_; }
+  uint32_t errors() const { return errors_; }
+  uint32_t resyncs() const { return resyncs_; }
+
+ private:
+  static void RxEventCallback(UART_HandleTypeDef *huart, uint16_t size);
+  static void ErrorCallback(UART_HandleTypeDef *huart);
+
+  void Restart();
+  void OnRxEvent(uint16_t size);
+
+  UART_HandleTypeDef *huart_;
+  uint8_t dma_buf_[REMOTE_DMA_BUF_SIZE] = {0};
+  uint16_t last_pos_ = 0;  // 上一帧结束时的DMA写入位置
+  RemoteFrameCallback frame_callback_ = nullptr;
+
+  RemoteState state_ = {0, 0, 0, 0, 0, rm::device::RcSwitchState::kUnknown, rm::device::RcSwitchState::kUnknown, 0, 0};
+
+  volatile uint32_t frames_ = 0;   // 有效帧数
+  volatile uint32_t errors_ = 0;   // 通道越界或串口错误
+  volatile uint32_t resyncs_ = 0;  // 帧错位重启次数
+
+  // 链路监测
+  RemoteLink link_ = REMOTE_LINK_NONE;
+  uint32_t lost_frames_ = 0;  // 失联时的有效帧计数, 用于判断恢复
+  uint32_t losses_ = 0;
+  volatile uint32_t window_max_gap_ = 0;  // 当前窗口内最大帧间隔(接收中断更新)
+  uint32_t window_start_ = 0;
+  uint32_t window_frames_ = 0;
+  uint16_t rate_ = 0;
+  uint16_t max_gap_ = 0;
+};
+
+extern RemoteReceiver remote_receiver;
+
+#endif /* REMOTE_RECEIVER_H */
@@ -0,0 +1,184 @@
+#include "Telemetry.h"
+
+#include "LatencyProbe.h"
+#include "main.h"
+
+namespace
+{
+  // 小端打包
+  inline void PutI16(uint8_t *buf, int16_t value)
+  {
+    buf[0] = static_cast<uint8_t>(value);
+    buf[1] = static_cast<uint8_t>(static_cast<uint16_t>(value) >> 8);
+  }
+
+  inline int16_t GetI16(const uint8_t *buf) { return static_cast<int16_t>(buf[0] | (buf[1] << 8)); }
+
+  // mm -> 0.1mm并限幅到int16
+  inline int16_t ToDeciMm(fp32 mm)
+  {
+    fp32 value = mm * 10.0f;
+    if (value > 32767.0f) return 32767;
+    if (value < -32768.0f) return -32768;
+    return static_cast<int16_t>(value);
+  }
+}  // namespace
+
+Telemetry::Telemetry(rm::hal::CanInterface &can) : rm::device::CanDevice(can, TELEMETRY_ID_COMMAND) {}
+
+/**
+ * @brief CAN2接收回调(中断上下文), 只记录命令, 由控制线程在下一周期应用
+ */
+void Telemetry::RxCallback(const rm::hal::CanMsg *msg)
+{
+  if (msg->rx_std_id != TELEMETRY_ID_COMMAND || msg->dlc < 1) return;
+
+  latency_probe.MarkInput();
+
+  const uint8_t *data = msg->data.data();
+  switch (data[0])
+  {
+    case TELEMETRY_CMD_SET_LEVEL:
+      if (msg->dlc >= 2 && (data[1] <= 4 || data[1] == TELEMETRY_LEVEL_RELEASE))
+      {
+        level_override_ = data[1];
+      }
+      break;
+
+    case TELEMETRY_CMD_SET_TARGET:
+      if (msg->dlc >= 5)
+      {
+        int16_t x = GetI16(&data[1]);
+        int16_t y = GetI16(&data[3]);
+        // 超出行程的目标会以全速撞向限位, 拒绝并在状态帧中报告
+        target_rejected_ = x > TELEMETRY_TARGET_X_LIMIT || x < -TELEMETRY_TARGET_X_LIMIT ||
+                           y > TELEMETRY_TARGET_Y_LIMIT || y < -TELEMETRY_TARGET_Y_LIMIT;
+        if (target_rejected_) break;
+        target_x_ = x;
+        target_y_ = y;
+        target_pending_ = true;
+      }
+      break;
+
+    case TELEMETRY_CMD_ARM:
+      armed_ = true;
+      break;
+
+    case TELEMETRY_CMD_DISARM:
+      armed_ = false;
+      break;
+
+    case TELEMETRY_CMD_SET_PERIOD:
+      if (msg->dlc >= 3)
+      {
+        uint16_t period = static_cast<uint16_t>(GetI16(&data[1]));
+        period_ = period < TELEMETRY_MIN_PERIOD ? TELEMETRY_MIN_PERIOD : period;
+      }
+      break;
+
+    case TELEMETRY_CMD_LATENCY:
+      if (msg->dlc < 2) break;
+      switch (data[1])
+      {
+        case LATENCY_CMD_DISABLE:
+          latency_probe.SetEnabled(false);
+          break;
+        case LATENCY_CMD_ENABLE:
+          latency_probe.SetEnabled(true);
+          break;
+        case LATENCY_CMD_DUMP:
+          latency_probe.StartDump();
+          break;
+        case LATENCY_CMD_RESET:
+          latency_probe.Reset();
+          break;
+        default:
+          break;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief 取出一次性目标位置命令
+ * @param x 目标x(mm)
+ * @param y 目标y(mm)
+ * @return 有新命令时返回true
+ */
+bool Telemetry::TakeTarget(fp64 *x, fp64 *y)
+{
+  if (!target_pending_) return false;
+
+  __disable_irq();
+  *x = target_x_;
+  *y = target_y_;
+  target_pending_ = false;
+  __enable_irq();
+  return true;
+}
+
+/**
+ * @brief 到达发送周期时发送一组遥测帧
+ * @param state 控制线程填写的状态快照
+ */
+void Telemetry::Update(const TelemetryState &state)
+{
+  uint32_t now = HAL_GetTick();
+  if (now - last_send_time_ < period_) return;
+  last_send_time_ = now;
+
+  SendAxis(TELEMETRY_ID_AXIS_X, state.x);
+  SendAxis(TELEMETRY_ID_AXIS_Y, state.y);
+  SendStatus(state);
+  SendRemote(state.remote);
+}
+
+/**
+ * @brief 单轴帧: [0:1]位置 [2:3]目标 (0.1mm) [4:5]转速(rpm) [6:7]电流指令
+ */
+void Telemetry::SendAxis(uint16_t id, const TelemetryAxis &axis)
+{
+  uint8_t buf[8];
+  PutI16(&buf[0], ToDeciMm(axis.pos));
+  PutI16(&buf[2], ToDeciMm(axis.target));
+  PutI16(&buf[4], axis.rpm);
+  PutI16(&buf[6], axis.current);
+  can_->Write(id, buf, sizeof(buf));
+}
+
+/**
+ * @brief 状态帧: [0]等级 [1]标志 [2:3]计时(10ms) [4]手动胜利点 [5]自动胜利点 [6]故障 [7]序号
+ */
+void Telemetry::SendStatus(const TelemetryState &state)
+{
+  uint8_t buf[8];
+  uint32_t timer = state.timer / 10;
+  if (timer > 0xFFFF) timer = 0xFFFF;
+
+  buf[0] = state.level;
+  buf[1] = state.flags | (level_override() ? TELEMETRY_FLAG_LEVEL_OVERRIDE : 0);
+  PutI16(&buf[2], static_cast<int16_t>(timer));
+  buf[4] = state.manul_point > 0xFF ? 0xFF : state.manul_point;
+  buf[5] = state.auto_point > 0xFF ? 0xFF : state.auto_point;
+  buf[6] = state.faults | (armed_ ? 0 : TELEMETRY_FAULT_DISARMED) |
+           (target_rejected_ ? TELEMETRY_FAULT_TARGET_REJECTED : 0);
+  buf[7] = seq_++;
+  can_->Write(TELEMETRY_ID_STATUS, buf, sizeof(buf));
+}
+
+/**
+ * @brief 遥控器链路帧: [0]链路状态 [1]帧率 [2:3]最大帧间隔(ms) [4:5]失联次数 [6:7]错误次数
+ */
+void Telemetry::SendRemote(const TelemetryRemote &remote)
+{
+  uint8_t buf[8];
+  buf[0] = remote.link;
+  buf[1] = remote.rate > 0xFF ? 0xFF : remote.rate;
+  PutI16(&buf[2], static_cast<int16_t>(remote.max_gap));
+  PutI16(&buf[4], static_cast<int16_t>(remote.losses > 0xFFFF ? 0xFFFF : remote.losses));
+  PutI16(&buf[6], static_cast<int16_t>(remote.errors > 0xFFFF ? 0xFFFF : remote.errors));
+  can_->Write(TELEMETRY_ID_REMOTE, buf, sizeof(buf));
+}
@@ -0,0 +1,127 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "librm.hpp"
+#include "struct_typedef.h"
+
+// CAN2遥测/命令帧ID
+#define TELEMETRY_ID_AXIS_X 0x301   // X轴: 位置 目标 转速 电流
+#define TELEMETRY_ID_AXIS_Y 0x302   // Y轴: 位置 目标 转速 电流
+#define TELEMETRY_ID_STATUS 0x303   // 等级 状态 计时 胜利点 故障
+#define TELEMETRY_ID_REMOTE 0x30A   // 遥控器链路: 帧率 失联次数 最大帧间隔 错误计数
+#define TELEMETRY_ID_COMMAND 0x310  // 外部裁判/测试台命令
+
+#define TELEMETRY_DEFAULT_PERIOD 10   // 默认发送周期(ms), 即100Hz
+#define TELEMETRY_MIN_PERIOD 2        // 最小发送周期(ms)
+#define TELEMETRY_TARGET_X_LIMIT 300  // 目标x范围±300mm, 与槽位行程一致
+#define TELEMETRY_TARGET_Y_LIMIT 100  // 目标y范围±100mm
+
+// 命令码(命令帧第0字节)
+enum TelemetryCommand
+{
+  TELEMETRY_CMD_SET_LEVEL = 0x01,   // [1]等级0~4, 0xFF释放回遥控器
+  TELEMETRY_CMD_SET_TARGET = 0x02,  // [1:2]x(mm) [3:4]y(mm), int16小端, 超出行程时拒绝
+  TELEMETRY_CMD_ARM = 0x03,         // 使能电机输出
+  TELEMETRY_CMD_DISARM = 0x04,      // 禁止电机输出(速度环保持0)
+  TELEMETRY_CMD_SET_PERIOD = 0x05,  // [1:2]发送周期(ms), uint16小端
+  TELEMETRY_CMD_LATENCY = 0x06,     // [1]LatencyCommand, 延迟统计开关/导出/清零
+};
+
+#define TELEMETRY_LEVEL_RELEASE 0xFF  // 释放等级覆盖
+
+// 故障位
+enum TelemetryFault
+{
+  TELEMETRY_FAULT_DISARMED = 1 << 0,         // 外部禁止输出
+  TELEMETRY_FAULT_OVER_TIME = 1 << 1,        // 兑矿超时
+  TELEMETRY_FAULT_X_LIMIT = 1 << 2,          // X轴到达边界
+  TELEMETRY_FAULT_Y_LIMIT = 1 << 3,          // Y轴到达边界
+  TELEMETRY_FAULT_REMOTE_LOST = 1 << 4,      // 遥控器失联, 失控保护中
+  TELEMETRY_FAULT_TARGET_REJECTED = 1 << 5,  // 目标位置超出行程被拒绝, 下一次有效的目标命令清除
+};
+
+// 状态标志位
+enum TelemetryFlag
+{
+  TELEMETRY_FLAG_READY = 1 << 0,             // EXCHANGE_READY状态
+  TELEMETRY_FLAG_GREEN_LIGHT = 1 << 1,       // 绿灯亮
+  TELEMETRY_FLAG_EXCHANGE_SUCCESS = 1 << 2,  // 兑矿成功
+  TELEMETRY_FLAG_LEVEL_OVERRIDE = 1 << 3,    // 等级由外部命令指定
+};
+
+// 单轴遥测数据
+struct TelemetryAxis
+{
+  fp32 pos;         // 当前位置(mm)
+  fp32 target;      // 目标位置(mm)
+  int16_t rpm;      // 电机转速
+  int16_t current;  // 电流指令
+};
+
+// 遥控器链路遥测数据
+struct TelemetryRemote
+{
+  uint8_t link;      // RemoteLink
+  uint16_t rate;     // 有效帧率(帧/s)
+  uint16_t max_gap;  // 统计窗口内最大帧间隔(ms)
+  uint32_t losses;   // 失联次数
+  uint32_t errors;   // 无效帧和串口错误次数
+};
+
+// 控制线程每周期填写的状态快照
+struct TelemetryState
+{
+  TelemetryAxis x;
+  TelemetryAxis y;
+  uint8_t level;         // 兑换等级
+  uint8_t flags;         // TelemetryFlag
+  uint8_t faults;        // TelemetryFault
+  uint32_t timer;        // 兑矿计时(ms)
+  uint16_t manul_point;  // 手动兑矿胜利点
+  uint16_t auto_point;   // 自动兑矿胜利点
+  TelemetryRemote remote;
+};
+
+/**
+ * @brief CAN2遥测通道
+ * @note  按可配置周期打包发送槽位状态, 并接收外部命令(设置等级/目标, 使能/禁止)
+ * @note  与1kHz电机总线CAN1分离, 监控流量不影响控制总线的确定性
+ */
+class Telemetry : public rm::device::CanDevice
+{
+ public:
+  explicit Telemetry(rm::hal::CanInterface &can);
+  ~Telemetry() = default;
+
+  void RxCallback(const rm::hal::CanMsg *msg) override;
+
+  // 控制线程调用, 到达发送周期时发送遥测帧
+  void Update(const TelemetryState &state);
+
+  // 取出一次性目标位置命令, 有新命令时返回true
+  bool TakeTarget(fp64 *x, fp64 *y);
+
+  bool armed() const { return armed_; }
+  bool level_override() const { return level_override_ != TELEMETRY_LEVEL_RELEASE; }
+  uint8_t override_level() const { return level_override_; }
+  uint16_t period() const { return period_; }
+
+ private:
+  void SendAxis(uint16_t id, const TelemetryAxis &axis);
+  void SendStatus(const TelemetryState &state);
+  void SendRemote(const TelemetryRemote &remote);
+
+  volatile bool armed_ = true;
+  volatile uint8_t level_override_ = TELEMETRY_LEVEL_RELEASE;
+  volatile uint16_t period_ = TELEMETRY_DEFAULT_PERIOD;
+
+  volatile bool target_pending_ = false;
+  volatile int16_t target_x_ = 0;
+  volatile int16_t target_y_ = 0;
+  volatile bool target_rejected_ = false;
+
+  uint32_t last_send_time_ = 0;
+  uint8_t seq_ = 0;
+};
+
+#endif /* TELEMETRY_H */
@@ -0,0 +1,117 @@
+#include "Teleop.h"
+
+#include <cmath>
+
+namespace
+{
+  inline fp32 Clamp(fp32 value, fp32 limit) { return value > limit ? limit : (value < -limit ? -limit : value); }
+}  // namespace
+
+/**
+ * @brief 死区 + 指数曲线, 输出-max_rpm~max_rpm
+ */
+fp32 Teleop::Shape(int16_t value) const
+{
+  int16_t magnitude = value < 0 ? -value : value;
+  if (magnitude <= config_.deadband) return 0;
+
+  // 死区外重新归一化到0~1, 避免越过死区时转速跳变
+  fp32 x = static_cast<fp32>(magnitude - config_.deadband) / (660 - config_.deadband);
+  if (x > 1.0f) x = 1.0f;
+  x = (1.0f - config_.expo) * x + config_.expo * x * x * x;
+  return (value < 0 ? -x : x) * config_.max_rpm;
+}
+
+void Teleop::DetectJog(Axis &axis, int16_t value)
+{
+  if (config_.jog_step <= 0) return;
+
+  if (axis.jog_direction == 0)
+  {
+    if (value > config_.jog_on || value < -config_.jog_on)
+    {
+      axis.jog_direction = value > 0 ? 1 : -1;
+      axis.jog_steps += axis.jog_direction;
+    }
+  }
+  else if (value < config_.jog_off && value > -config_.jog_off)
+  {
+    axis.jog_direction = 0;
+  }
+}
+
+void Teleop::OnFrame(const RemoteState &state)
+{
+  x_.target = Shape(state.left_x);
+  y_.target = Shape(state.left_y);
+  DetectJog(x_, state.right_x);
+  DetectJog(y_, state.right_y);
+}
+
+void Teleop::Reset()
+{
+  __disable_irq();
+  x_.jog_steps = 0;
+  y_.jog_steps = 0;
+  __enable_irq();
+
+  x_.jogging = false;
+  y_.jogging = false;
+  x_.output = 0;
+  y_.output = 0;
+  last_update_ = HAL_GetTick();
+}
+
+fp32 Teleop::UpdateAxis(Axis &axis, fp64 pos, uint32_t dt)
+{
+  fp32 target = axis.target;
+
+  __disable_irq();
+  int8_t steps = axis.jog_steps;
+  axis.jog_steps = 0;
+  __enable_irq();
+
+  if (target != 0)
+  {
+    // 摇杆优先, 取消点动
+    axis.jogging = false;
+  }
+  else if (steps != 0)
+  {
+    // 取整到能到达的位置, 步长不足一格时至少走一格
+    fp64 cells = round(steps * config_.jog_step / axis.resolution);
+    if (cells == 0) cells = steps > 0 ? 1 : -1;
+    axis.jog_target = (axis.jogging ? axis.jog_target : pos) + cells * axis.resolution;
+    axis.jogging = true;
+  }
+
+  if (axis.jogging)
+  {
+    fp64 error = axis.jog_target - pos;
+    if (fabs(error) < axis.resolution / 2)
+    {
+      axis.jogging = false;
+    }
+    else
+    {
+      target = Clamp(static_cast<fp32>(error) * config_.jog_gain, config_.jog_max_rpm);
+    }
+  }
+
+  // 加速度限制
+  fp32 max_delta = config_.accel * dt;
+  axis.output += Clamp(target - axis.output, max_delta);
+  return axis.output;
+}
+
+void Teleop::Update(fp64 x_pos, fp64 y_pos, fp32 *x_rpm, fp32 *y_rpm)
+{
+  uint32_t now = HAL_GetTick();
+  uint32_t dt = now - last_update_;
+  if (dt == 0) dt = 1;
+  if (dt > 20) dt = 20;  // 长时间未调用时不允许一步跳到目标
+  last_update_ = now;
+
+  *x_rpm = UpdateAxis(x_, x_pos, dt);
+  *y_rpm = UpdateAxis(y_, y_pos, dt);
+}
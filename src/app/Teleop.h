@@ -0,0 +1,69 @@
+#ifndef TELEOP_H
+#define TELEOP_H
+
+#include "RemoteReceiver.h"
+#include "struct_typedef.h"
+
+// 手控参数
+struct TeleopConfig
+{
+  int16_t deadband = 30;       // 左摇杆死区(通道值)
+  fp32 expo = 0.6f;            // 指数曲线系数, 0为线性, 1为纯三次
+  fp32 max_rpm = 10000.0f;     // 摇杆满量程对应的电机转速
+  fp32 accel = 40.0f;          // 加速度限制(rpm/ms), 满速约250ms
+  fp32 jog_step = 1.0f;        // 右摇杆点动步长(mm), 0表示关闭点动
+  fp32 jog_gain = 400.0f;      // 点动位置环比例(rpm/mm)
+  fp32 jog_max_rpm = 4000.0f;  // 点动最大转速
+  int16_t jog_on = 400;        // 右摇杆超过该值触发一步
+  int16_t jog_off = 200;       // 右摇杆回到该值以内才能再次触发
+};
+
+/**
+ * @brief 遥控器手控
+ * @note  左摇杆经死区和指数曲线整形为目标转速, 中心附近精细、满杆快速; 整形在收到DR16帧的中断中完成,
+ *        加速度限制、点动和电机输出仍由控制线程在下一个周期计算, 命令到电机的延迟不变
+ * @note  右摇杆每拨动一次按jog_step点动一步, 到位后保持; 左摇杆操作时取消点动.
+ *        位置按转子整圈计数, 点动目标取整到位置分辨率的整数倍, 误差小于半格即到位
+ */
+class Teleop
+{
+ public:
+  // x_resolution/y_resolution: 两轴位置计数的最小变化量(mm), 即每转对应的行程
+  Teleop(const TeleopConfig &config, fp64 x_resolution, fp64 y_resolution) : config_(config)
+  {
+    x_.resolution = x_resolution;
+    y_.resolution = y_resolution;
+  }
+
+  // 接收中断调用, 根据新帧更新目标
+  void OnFrame(const RemoteState &state);
+
+  // 进入/退出手控或失联时清零输出和点动
+  void Reset();
+
+  // 控制线程每周期调用, 输入当前位置(mm), 输出两轴电机目标转速
+  void Update(fp64 x_pos, fp64 y_pos, fp32 *x_rpm, fp32 *y_rpm);
+
+ private:
+  struct Axis
+  {
+    volatile fp32 target = 0;       // 摇杆整形后的目标转速
+    volatile int8_t jog_steps = 0;  // 待执行的点动步数
+    int8_t jog_direction = 0;       // 右摇杆当前拨向, 用于边沿检测
+    bool jogging = false;           // 正在点动
+    fp64 jog_target = 0;            // 点动目标位置(mm)
+    fp32 output = 0;                // 加速度限制后的转速
+    fp64 resolution = 0;            // 位置分辨率(mm)
+  };
+
+  fp32 Shape(int16_t value) const;
+  void DetectJog(Axis &axis, int16_t value);
+  fp32 UpdateAxis(Axis &axis, fp64 pos, uint32_t dt);
+
+  TeleopConfig config_;
+  Axis x_;
+  Axis y_;
+  uint32_t last_update_ = 0;
+};
+
+#endif /* TELEOP_H */
@@ -2,84 +2,159 @@
 #include "cmsis_os.h"
 #include "main.h"
 
+#include "Clock.h"
+#include "DisplayScheduler.h"
 #include "XYControlTask.h"
-#include "oled.h"
+
+// 计时线程的唤醒信号(任务通知)
+#define TIMING_SIGNAL_SWITCH 0x01   // 微动开关边沿, 由EXTI中断发出
+#define TIMING_SIGNAL_DISPLAY 0x02  // 控制线程发布了新画面
+#define TIMING_SIGNAL_MESSAGE 0x04  // 控制线程的消息
+#define TIMING_SIGNAL_ALL 0x07
+
+#define SWITCH_DEBOUNCE_US 20000  // 20ms消抖时间
 
 typedef struct
 {
-  uint32_t press_start_time;   // 按钮按下时刻
-  uint8_t prev_button_state;   // 记录上一次的按钮状态
+  uint64_t press_start_time;   // 按钮按下时刻(us)
   uint8_t button_debounced;    // 消抖后按钮状态
   uint8_t long_press_handled;  // 长按已处理标志
 } ButtonState;
 ButtonState button_state = {0};
 
-uint32_t sys_tick = 0;        // 系统时间，用于计算微动开关触发有效时间
-bool button_changed = false;  // 按钮按下标志(计时相关标志位)
+// 微动开关消抖状态
+typedef enum
+{
+  SWITCH_RELEASED,         // 松开
+  SWITCH_PRESS_PENDING,    // 检测到按下边沿, 等待抖动结束
+  SWITCH_PRESSED,          // 确认按下
+  SWITCH_RELEASE_PENDING,  // 检测到松开边沿, 等待抖动结束
+} SwitchState;
+
+// 微动开关边沿捕获, 由EXTI中断和计时线程共同维护
+typedef struct
+{
+  volatile uint8_t state;      // SwitchState
+  volatile uint64_t edge_us;   // 最近一次边沿时刻(us), 之后没有新边沿才算抖动结束
+  volatile uint64_t press_us;  // 按下的首个边沿时刻(us), 确认后作为按下时刻
+} SwitchCapture;
+static SwitchCapture switch_capture = {SWITCH_RELEASED, 0, 0};
+
+// 消息均为32位: 控制线程的消息低8位为TimingMessage, 8~15位为参数; 按压消息为触发时刻的低32位.
+// 每次兑换只有几条消息, 队列不会满
+osMessageQDef(timing_queue, 8, uint32_t);
+osMessageQDef(button_queue, 4, uint32_t);
+static osMessageQId timing_queue;  // 控制线程 -> 计时线程
+static osMessageQId button_queue;  // 计时线程 -> 控制线程
+static osThreadId volatile timing_thread = NULL;  // 计时线程开始运行前不发送信号, 消息留在队列中
+
+uint64_t sys_tick = 0;                  // 系统时间(us)，用于计算微动开关触发有效时间
+static bool green_light = false;        // 绿灯, 由控制线程的消息切换
+static uint64_t green_light_time = 0;   // 绿灯亮起时刻(us), 此后按下的开关才有效
+static uint32_t hold_us = 1000000;      // 有效按压需要保持的时间(us), 随兑换等级变化
+static uint64_t debounce_deadline = 0;  // 开关抖动结束、可以确认状态的时刻(us), 0表示没有边沿待确认
 
 // 个人习惯，不强制要求
 extern "C"
 {
   /**
-   * @brief 更新按钮状态（带消抖）
+   * @brief 微动开关(PI9)边沿中断, 记录边沿时刻并唤醒计时线程
+   * @note  按下的首个边沿时刻在确认前保留, 之后的抖动只刷新最近边沿时刻
    */
-  void update_button_states(void)
+  void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
   {
-    static uint32_t last_debounce_time = 0;
-    const uint16_t debounce_delay = 20;  // 20ms消抖时间
+    if (GPIO_Pin != GPIO_PIN_9) return;
 
-    uint8_t current_state = HAL_GPIO_ReadPin(GPIOI, GPIO_PIN_9);  // 获取当前按钮状态
+    uint64_t now = ClockMicros();
+    switch_capture.edge_us = now;
+    uint8_t pressed = HAL_GPIO_ReadPin(GPIOI, GPIO_PIN_9) == GPIO_PIN_RESET;
+    if (switch_capture.state == SWITCH_RELEASED && pressed)
+    {
+      switch_capture.press_us = now;
+      switch_capture.state = SWITCH_PRESS_PENDING;
+    }
+    else if (switch_capture.state == SWITCH_PRESSED && !pressed)
+    {
+      switch_capture.state = SWITCH_RELEASE_PENDING;
+    }
+    if (timing_thread) osSignalSet(timing_thread, TIMING_SIGNAL_SWITCH);
+  }
 
-    // 若当前状态与上一次状态不同，则进入消抖逻辑
-    if (current_state != button_state.prev_button_state)
+  /**
+   * @brief 处理控制线程的消息
+   */
+  void receive_messages(void)
+  {
+    osEvent event;
+    while ((event = osMessageGet(timing_queue, 0)).status == osEventMessage)
     {
-      last_debounce_time = sys_tick;
+      uint8_t arg = event.value.v >> 8;
+      switch (event.value.v & 0xFF)
+      {
+        case TIMING_LEVEL_CHANGED:
+          // 3、4级按下40毫秒, 其余按下1秒
+          hold_us = (arg == LEVEL_3 || arg == LEVEL_4) ? 40000 : 1000000;
+          green_light = false;
+          break;
+        case TIMING_EXCHANGE_READY:
+          green_light = true;
+          green_light_time = ClockMicros();
+          break;
+        default:  // 兑换完成或超时
+          green_light = false;
+          break;
+      }
     }
+  }
 
-    // 若消抖时间超过阈值，则更新按钮状态
-    if ((sys_tick - last_debounce_time) > debounce_delay)
+  /**
+   * @brief 更新按钮状态（带消抖）
+   * @note  边沿由中断捕获, 这里只在最后一次边沿之后稳定超过消抖时间时按引脚电平确认状态;
+   *        按下期间的抖动不改变按下时刻, 短暂的毛刺回到松开状态
+   */
+  void update_button_states(void)
+  {
+    __disable_irq();
+    uint8_t state = switch_capture.state;
+    if ((state == SWITCH_PRESS_PENDING || state == SWITCH_RELEASE_PENDING) &&
+        ClockMicros() - switch_capture.edge_us >= SWITCH_DEBOUNCE_US)
     {
-      button_state.button_debounced = current_state;
+      state = HAL_GPIO_ReadPin(GPIOI, GPIO_PIN_9) == GPIO_PIN_RESET ? SWITCH_PRESSED : SWITCH_RELEASED;
+      switch_capture.state = state;
     }
+    uint64_t press_us = switch_capture.press_us;
+    bool pending = state == SWITCH_PRESS_PENDING || state == SWITCH_RELEASE_PENDING;
+    debounce_deadline = pending ? switch_capture.edge_us + SWITCH_DEBOUNCE_US : 0;
+    __enable_irq();
 
-    // 记录当前状态
-    button_state.prev_button_state = current_state;
+    // 确认松开之前都视为按下, 按下时刻为首个边沿
+    if (state == SWITCH_PRESSED || state == SWITCH_RELEASE_PENDING)
+    {
+      button_state.button_debounced = GPIO_PIN_RESET;
+      button_state.press_start_time = press_us;
+    }
+    else
+    {
+      button_state.button_debounced = GPIO_PIN_SET;
+    }
   }
 
   /**
    * @brief 处理按钮逻辑
+   * @note  绿灯亮起之后按下、按满规定时间才算有效, 每次按下只发送一次; 触发时刻由按下边沿推算,
+   *        不含消抖和唤醒延迟. 是否计分由控制线程按兑换状态判定
    */
   void process_buttons(void)
   {
-    // 按钮按下（消抖后）
+    // 按钮按下（消抖后）, 按下时刻由update_button_states()给出
     if (button_state.button_debounced == GPIO_PIN_RESET)
     {
-      // 记录首次按下时间
-      if (button_state.press_start_time == 0)
+      if (green_light && !button_state.long_press_handled && button_state.press_start_time >= green_light_time &&
+          sys_tick - button_state.press_start_time >= hold_us)
       {
-        button_state.press_start_time = sys_tick;
-        button_state.long_press_handled = 0;  // 重置长按处理标志
-      }
-
-      if (exchange_level == LEVEL_0 || exchange_level == LEVEL_1 || exchange_level == LEVEL_2)
-      {
-        // 按下超过1秒且未处理过
-        if (!button_state.long_press_handled && (sys_tick - button_state.press_start_time) >= 1000 && !over_time && !exchange_success)
-        {
-          green_light = !green_light;  // 切换LED显示模式
-          button_changed = true;       // 按钮按下标志置位
-          button_state.long_press_handled = 1;
-        }
-      }
-      else if (exchange_level == LEVEL_3 || exchange_level == LEVEL_4)
-      {
-        // 按下超过40毫秒且未处理过
-        if (!button_state.long_press_handled && (sys_tick - button_state.press_start_time) >= 40 && !over_time && !exchange_success)
-        {
-          green_light = !green_light;  // 切换LED显示模式
-          button_changed = true;       // 按钮按下标志置位
-          button_state.long_press_handled = 1;
-        }
+        osMessagePut(button_queue, static_cast<uint32_t>(button_state.press_start_time + hold_us), 0);
+        green_light = false;  // 立即灭绿灯
+        button_state.long_press_handled = 1;
       }
     }
     // 按钮松开
@@ -107,6 +182,61 @@ extern "C"
       HAL_GPIO_WritePin(GPIOF, GPIO_PIN_10, GPIO_PIN_RESET);
     }
   }
+
+  /**
+   * @brief 距下一件待办的事情的时间(ms), 没有待办的事情时返回osWaitForever
+   * @note  待办的事情: 开关抖动结束、有效按压按满时间、屏幕刷新
+   */
+  uint32_t next_wake_delay(void)
+  {
+    uint64_t wake = debounce_deadline ? debounce_deadline : UINT64_MAX;
+    if (green_light && button_state.button_debounced == GPIO_PIN_RESET && !button_state.long_press_handled &&
+        button_state.press_start_time >= green_light_time)
+    {
+      uint64_t hold_end = button_state.press_start_time + hold_us;
+      if (hold_end < wake) wake = hold_end;
+    }
+
+    uint32_t delay = display_scheduler.NextPollDelay();
+    if (delay == DISPLAY_IDLE) delay = osWaitForever;
+    if (wake != UINT64_MAX)
+    {
+      uint64_t now = ClockMicros();
+      uint32_t ms = wake > now ? static_cast<uint32_t>((wake - now + 999) / 1000) : 1;
+      if (ms < delay) delay = ms;
+    }
+    return delay;
+  }
+}
+
+void TimingThreadInit(void)
+{
+  timing_queue = osMessageCreate(osMessageQ(timing_queue), NULL);
+  button_queue = osMessageCreate(osMessageQ(button_queue), NULL);
+}
+
+/**
+ * @brief 发送消息给计时线程
+ * @param message 消息类型
+ * @param arg 参数, TIMING_LEVEL_CHANGED为新的兑换等级
+ */
+void TimingPost(TimingMessage message, uint8_t arg)
+{
+  if (osMessagePut(timing_queue, message | arg << 8, 0) != osOK) return;
+  if (timing_thread) osSignalSet(timing_thread, TIMING_SIGNAL_MESSAGE);
+}
+
+void TimingNotifyDisplay()
+{
+  if (timing_thread) osSignalSet(timing_thread, TIMING_SIGNAL_DISPLAY);
+}
+
+bool TimingTakeButton(uint32_t *trigger_us)
+{
+  osEvent event = osMessageGet(button_queue, 0);
+  if (event.status != osEventMessage) return false;
+  *trigger_us = event.value.v;
+  return true;
 }
 
 /**
@@ -118,18 +248,19 @@ void TimingThread(void const *argument)
 {
   (void)argument;
 
-  button_state.prev_button_state = 1;  // 按钮初始状态为松开
-
   HAL_GPIO_WritePin(GPIOF, GPIO_PIN_10, GPIO_PIN_RESET);  // 常灭模式
-  green_light = false;                                    // 初始状态为常灭
+  timing_thread = osThreadGetId();
 
   while (1)
   {
     // 更新系统时间
-    sys_tick = HAL_GetTick();
+    sys_tick = ClockMicros();
+
+    // 控制线程的消息: 换挡、可兑换、兑换完成、超时
+    receive_messages();
 
-    // OLED屏幕刷新
-    OLED_ShowFrame();
+    // OLED屏幕刷新, 帧率和各区域的刷新间隔由调度决定
+    display_scheduler.Poll();
 
     // 更新按钮状态
     update_button_states();
@@ -140,7 +271,8 @@ void TimingThread(void const *argument)
     // 更新LED显示
     update_leds();
 
-    // 冷却cd
-    osDelay(10);
+    // 休眠到下一件待办的事情, 开关边沿、控制线程的消息和新画面会提前唤醒;
+    // 信号在等待之前到达时保留在任务通知中, 等待立即返回, 不会丢失
+    osSignalWait(TIMING_SIGNAL_ALL, next_wake_delay());
   }
 }
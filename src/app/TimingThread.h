@@ -1,17 +1,39 @@
 #ifndef __TIMINGTHREAD_H__
 #define __TIMINGTHREAD_H__
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
   extern void TimingThread(void const *argument);
+  void TimingThreadInit(void);  // 创建消息队列, 在启动调度器之前调用
 
 #ifdef __cplusplus
 }
 #endif
 
-extern bool button_changed;
+/**
+ * 控制线程与计时线程之间只通过消息交互, 不共享标志位:
+ * 兑换状态(等级、是否超时、是否完成)只归控制线程, 状态变化时发消息给计时线程;
+ * 绿灯和微动开关只归计时线程, 按压有效时把触发时刻发给控制线程.
+ */
+
+// 控制线程 -> 计时线程
+enum TimingMessage
+{
+  TIMING_LEVEL_CHANGED,      // 换挡, 参数为新的兑换等级, 决定按压需要保持的时间; 灭绿灯
+  TIMING_EXCHANGE_READY,     // 可兑换, 亮绿灯, 此后按下的微动开关才有效
+  TIMING_EXCHANGE_COMPLETE,  // 兑换完成, 灭绿灯
+  TIMING_TIMEOUT,            // 超时, 灭绿灯
+};
+
+void TimingPost(TimingMessage message, uint8_t arg = 0);
+void TimingNotifyDisplay();  // 发布了新画面, 唤醒计时线程刷新屏幕
+
+// 计时线程 -> 控制线程: 取出一次有效按压按满规定时间的时刻(us, 低32位), 不阻塞
+bool TimingTakeButton(uint32_t *trigger_us);
 
 #endif /* __TIMINGTHREAD_H__ */
@@ -0,0 +1,132 @@
+#include "Trajectory.h"
+
+#include <cmath>
+#include "main.h"
+
+namespace
+{
+  inline void PutI16(uint8_t *buf, int16_t value)
+  {
+    buf[0] = static_cast<uint8_t>(value);
+    buf[1] = static_cast<uint8_t>(static_cast<uint16_t>(value) >> 8);
+  }
+
+  inline void PutU32(uint8_t *buf, uint32_t value)
+  {
+    buf[0] = static_cast<uint8_t>(value);
+    buf[1] = static_cast<uint8_t>(value >> 8);
+    buf[2] = static_cast<uint8_t>(value >> 16);
+    buf[3] = static_cast<uint8_t>(value >> 24);
+  }
+
+  // 转为0.1单位并限幅到int16
+  inline int16_t ToDeci(fp32 value)
+  {
+    value *= 10.0f;
+    if (value > 32767.0f) return 32767;
+    if (value < -32768.0f) return -32768;
+    return static_cast<int16_t>(lroundf(value));
+  }
+
+  const uint32_t kMinSegmentTime = 50;  // 用于测速的最短段时长(ms)
+}  // namespace
+
+TrajectoryBroadcaster::TrajectoryBroadcaster(rm::hal::CanInterface &can, fp32 x_limit, fp32 y_limit) :
+    can_(&can), x_limit_(x_limit), y_limit_(y_limit)
+{
+}
+
+/**
+ * @brief 检测单轴是否开始新的轨迹段
+ * @return 段参数发生变化时返回true
+ */
+bool TrajectoryBroadcaster::UpdateAxis(AxisTracker &axis, fp64 pos, int8_t direction, bool moving,
+                                       fp32 nominal_speed, uint32_t now, bool force)
+{
+  // 匀速轴在换向时开始新段, 静止轴在目标变化时开始新段
+  bool same_motion = moving ? (axis.moving && direction == axis.direction)
+                            : (!axis.moving && fabsf(static_cast<fp32>(pos) - axis.segment.start_pos) < 0.5f);
+  if (!force && same_motion) return false;
+
+  // 换向时用上一段的实测速度修正标称速度
+  uint32_t duration = now - axis.segment.start_time;
+  if (axis.moving && moving && duration >= kMinSegmentTime)
+  {
+    fp32 measured = fabsf(static_cast<fp32>(pos) - axis.segment.start_pos) * 1000.0f / duration;
+    axis.speed = axis.speed > 0 ? 0.5f * (axis.speed + measured) : measured;
+  }
+
+  fp32 speed = axis.speed > 0 ? axis.speed : nominal_speed;
+
+  axis.moving = moving;
+  axis.direction = direction;
+  axis.segment.start_time = now;
+  axis.segment.start_pos = static_cast<fp32>(pos);
+  axis.segment.velocity = moving ? direction * speed : 0;
+  if (!moving) axis.speed = 0;
+  return true;
+}
+
+void TrajectoryBroadcaster::Update(uint8_t level, fp64 x_pos, fp64 y_pos, int8_t x_direction, int8_t y_direction,
+                                   bool x_moving, bool y_moving, fp32 x_speed, fp32 y_speed)
+{
+  uint32_t now = HAL_GetTick();
+  bool level_changed = level != level_;
+  level_ = level;
+
+  bool x_changed = UpdateAxis(x_, x_pos, x_direction, x_moving, x_speed, now, level_changed);
+  bool y_changed = UpdateAxis(y_, y_pos, y_direction, y_moving, y_speed, now, level_changed);
+
+  // 时钟同步帧
+  if (now - last_clock_time_ >= TRAJECTORY_CLOCK_PERIOD)
+  {
+    last_clock_time_ = now;
+    SendClock(now);
+  }
+
+  // 段变化时立即发送, 否则低频重发供后加入的客户端使用
+  if (x_changed || y_changed)
+  {
+    segment_seq_++;
+    if (x_changed) SendSegment(TRAJECTORY_ID_SEGMENT_X, x_.segment);
+    if (y_changed) SendSegment(TRAJECTORY_ID_SEGMENT_Y, y_.segment);
+    SendPath();
+    last_repeat_time_ = now;
+  }
+  else if (now - last_repeat_time_ >= TRAJECTORY_REPEAT_PERIOD)
+  {
+    last_repeat_time_ = now;
+    SendSegment(TRAJECTORY_ID_SEGMENT_X, x_.segment);
+    SendSegment(TRAJECTORY_ID_SEGMENT_Y, y_.segment);
+    SendPath();
+  }
+}
+
+void TrajectoryBroadcaster::SendSegment(uint16_t id, const TrajectorySegment &segment)
+{
+  uint8_t buf[8];
+  PutU32(&buf[0], segment.start_time);
+  PutI16(&buf[4], ToDeci(segment.start_pos));
+  PutI16(&buf[6], ToDeci(segment.velocity));
+  can_->Write(id, buf, sizeof(buf));
+}
+
+void TrajectoryBroadcaster::SendPath()
+{
+  uint8_t buf[8];
+  buf[0] = level_;
+  buf[1] = (x_.moving ? 0x01 : 0) | (y_.moving ? 0x02 : 0);
+  PutI16(&buf[2], ToDeci(x_limit_));
+  PutI16(&buf[4], ToDeci(y_limit_));
+  buf[6] = segment_seq_;
+  buf[7] = 0;
+  can_->Write(TRAJECTORY_ID_PATH, buf, sizeof(buf));
+}
+
+void TrajectoryBroadcaster::SendClock(uint32_t now)
+{
+  uint8_t buf[8] = {0};
+  PutU32(&buf[0], now);
+  buf[4] = clock_seq_++;
+  can_->Write(TRAJECTORY_ID_CLOCK, buf, sizeof(buf));
+}
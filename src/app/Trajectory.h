@@ -0,0 +1,83 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include "librm.hpp"
+#include "struct_typedef.h"
+
+// CAN2轨迹广播帧ID
+#define TRAJECTORY_ID_CLOCK 0x304      // 时钟同步: [0:3]MCU时间(ms) [4]序号
+#define TRAJECTORY_ID_SEGMENT_X 0x305  // X轴段: [0:3]起始时间(ms) [4:5]起始位置(0.1mm) [6:7]速度(0.1mm/s)
+#define TRAJECTORY_ID_SEGMENT_Y 0x306  // Y轴段: 同上
+#define TRAJECTORY_ID_PATH 0x307       // 路径: [0]等级 [1]运动轴 [2:3]X边界(0.1mm) [4:5]Y边界(0.1mm) [6]段序号
+
+#define TRAJECTORY_CLOCK_PERIOD 100   // 时钟同步周期(ms)
+#define TRAJECTORY_REPEAT_PERIOD 200  // 轨迹参数重发周期(ms)
+
+/**
+ * @brief 单轴轨迹段
+ * @note  客户端按 p(t) = start_pos + velocity * (t - start_time) 计算位置,
+ *        超出[-limit, limit]时在边界处反射, 即可得到往复运动中的槽位坐标
+ */
+struct TrajectorySegment
+{
+  uint32_t start_time;  // 段起始时间(MCU ms)
+  fp32 start_pos;       // 段起始位置(mm)
+  fp32 velocity;        // 速度(mm/s), 静止轴为0
+};
+
+/**
+ * @brief 槽位轨迹广播
+ * @note  三、四级时槽位只在本MCU内可知, 机器人视觉追踪有延迟。
+ *        本模块只在段变化(换向/切换等级)时发送段参数, 并周期发送时钟同步帧,
+ *        客户端本地即可预测槽位未来位置, 代替高频位置流
+ */
+class TrajectoryBroadcaster
+{
+ public:
+  explicit TrajectoryBroadcaster(rm::hal::CanInterface &can, fp32 x_limit, fp32 y_limit);
+  ~TrajectoryBroadcaster() = default;
+
+  /**
+   * @brief 控制线程每周期调用
+   * @param level 兑换等级
+   * @param x_pos/y_pos 匀速轴传当前位置, 静止轴传目标位置(mm)
+   * @param x_direction/y_direction 匀速轴的运动方向
+   * @param x_moving/y_moving 该轴是否处于匀速往复
+   * @param x_speed/y_speed 匀速轴的标称速度(mm/s)
+   */
+  void Update(uint8_t level, fp64 x_pos, fp64 y_pos, int8_t x_direction, int8_t y_direction, bool x_moving,
+              bool y_moving, fp32 x_speed, fp32 y_speed);
+
+  const TrajectorySegment &x_segment() const { return x_.segment; }
+  const TrajectorySegment &y_segment() const { return y_.segment; }
+
+ private:
+  struct AxisTracker
+  {
+    TrajectorySegment segment;
+    int8_t direction;
+    bool moving;
+    fp32 speed;  // 实测速度(mm/s), 0表示尚未测得
+  };
+
+  bool UpdateAxis(AxisTracker &axis, fp64 pos, int8_t direction, bool moving, fp32 nominal_speed, uint32_t now,
+                  bool force);
+  void SendSegment(uint16_t id, const TrajectorySegment &segment);
+  void SendPath();
+  void SendClock(uint32_t now);
+
+  rm::hal::CanInterface *can_;
+  fp32 x_limit_;
+  fp32 y_limit_;
+
+  AxisTracker x_{};
+  AxisTracker y_{};
+  uint8_t level_ = 0xFF;
+  uint8_t segment_seq_ = 0;
+  uint8_t clock_seq_ = 0;
+
+  uint32_t last_clock_time_ = 0;
+  uint32_t last_repeat_time_ = 0;
+};
+
+#endif /* TRAJECTORY_H */
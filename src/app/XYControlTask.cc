@@ -3,48 +3,78 @@
 #include <cstdlib>
 #include "cmsis_os.h"
 #include "can.h"
-#include "usart.h"
 
+#include "Clock.h"
+#include "DisplayScheduler.h"
+#include "LatencyProbe.h"
+#include "RemoteEvents.h"
+#include "Teleop.h"
 #include "TimingThread.h"
+#include "Telemetry.h"
+#include "Trajectory.h"
+#include "OledWidget.h"
 #include "oled.h"
 
 using rm::hal::Can;                  // 引入CAN总线
 Can can1(hcan1);                     // 创建CAN对象
+Can can2(hcan2);                     // 遥测/命令总线
 XYControl *XYcontrol;                // 创建XY二维控制对象
 rm::f32 motor_speed_static = 20000;  // 正常移动速度变量
 rm::f32 motor_speed_move = 8000;     // 匀速移动速度变量
 
-// 遥控器对象以及电机遥控数据变量创建
-static rm::hal::Serial *remote_uart;
-static DR16 *remote;
+// 遥控器手控
+static Teleop *teleop;
+
+// 由输入事件维护的遥控器状态
+struct InputState
+{
+  RcSwitchState switch_l = RcSwitchState::kUnknown;  // 已确认的拨杆挡位
+  RcSwitchState switch_r = RcSwitchState::kUnknown;
+  bool manual = false;        // 拨轮手控
+  bool stick_active = false;  // 摇杆操作中
+  uint8_t override_level = TELEMETRY_LEVEL_RELEASE;
+};
+static InputState input;
+static bool level_pending = false;  // 有换挡事件待处理
+static bool remote_lost = false;    // 遥控器失联, 失控保护中
+
+// CAN2遥测通道
+static Telemetry *telemetry;
+static TrajectoryBroadcaster *trajectory;
 
 // 全局变量声明
 ExchangeState exchange_state = EXCHANGE_IDLE;
-ExchangeLevel exchange_level = LEVEL_0;
-ExchangeLevel last_exchange_level = LEVEL_0;
+static ExchangeLevel exchange_level = LEVEL_0;
 
 // 运动相关全局变量
-float rc_x_data = 0;
-float rc_y_data = 0;
+fp32 rc_x_data = 0;
+fp32 rc_y_data = 0;
 fp64 x_error = 0;
 fp64 y_error = 0;
 fp64 step = static_cast<fp64>(2) / 36;
 const fp32 position_tolerance = 1.0f;  // 位置容差(mm)
 
+// 屏幕上随状态变化的内容, 值不变时不重绘
+static OledNumber time_field(60, 6, 68, &afont16x8);          // 兑矿用时(s)或OVERTIME
+static OledNumber manul_point_field(80, 24, 48, &afont16x8);  // 手动兑矿胜利点
+static OledNumber auto_point_field(90, 42, 38, &afont16x8);   // 自动兑矿胜利点
+
+// 调参时把状态画面换成位置曲线(点为目标, 线为实际, 单位0.1mm, 每20个控制周期一列): 0关闭 1 X轴 2 Y轴
+#ifndef XY_OLED_PLOT
+#define XY_OLED_PLOT 0
+#endif
+static OledPlot position_plot(0, 0, 128, 64, XY_OLED_PLOT == 2 ? -1000 : -3000, XY_OLED_PLOT == 2 ? 1000 : 3000, 20);
+
 // 计时相关全局变量
-char time_str[12];         // 时间字符串
-char manul_point_str[16];  // 胜利点字符串
-char auto_point_str[16];   // 胜利点字符串
 fp32 proportion = 1.0f;
-uint32_t move_time = 5000;
+uint32_t move_time = 5000;  // 开始计时前的移动时间(ms)
 
-// 各种标志位
-bool single_random = false;
+// 各种标志位, 兑换状态只归控制线程, 变化时发消息给计时线程
 bool reset_flag = false;
 bool level_selected = false;
-bool green_light = false;
-bool exchange_success = false;
-bool over_time = false;
+static bool green_light = false;
+static bool exchange_success = false;
+static bool over_time = false;
 
 /**
  * @brief 创建一个电机控制类(初始化列表)
@@ -70,46 +100,67 @@ extern "C"
   {
     // 字符内容初始化
     OLED_NewFrame();
+    if (XY_OLED_PLOT)
+    {
+      display_scheduler.SetPriority(position_plot, DISPLAY_PRIORITY_HIGH);
+      position_plot.Invalidate();
+      OLED_Publish();
+      return;
+    }
     // OLED_PrintString(46, 0, "IRBOT", &font16x16, OLED_COLOR_NORMAL);
     OLED_PrintString(0, 6, "TIME:", &font16x16, OLED_COLOR_NORMAL);
     OLED_PrintString(0, 24, "MANPOINT:", &font16x16, OLED_COLOR_NORMAL);
     OLED_PrintString(0, 42, "AUTOPOINT:", &font16x16, OLED_COLOR_NORMAL);
-    OLED_ShowFrame();
+    OLED_Publish();
+
+    // 计时随时在走, 优先显示; 胜利点晚一点显示也无妨
+    display_scheduler.SetPriority(time_field, DISPLAY_PRIORITY_HIGH);
+    display_scheduler.SetPriority(manul_point_field, DISPLAY_PRIORITY_LOW);
+    display_scheduler.SetPriority(auto_point_field, DISPLAY_PRIORITY_LOW);
   }
 
   // OLED显示手动和自动兑矿胜利点
   void OLED_ShowPoint()
   {
-    sprintf(manul_point_str, "%lu ", XYcontrol->manul_victory_point);
-    OLED_PrintASCIIString(80, 24, manul_point_str, &afont16x8, OLED_COLOR_NORMAL);
-
-    sprintf(auto_point_str, "%lu ", XYcontrol->auto_victory_point);
-    OLED_PrintASCIIString(90, 42, auto_point_str, &afont16x8, OLED_COLOR_NORMAL);
+    if (XY_OLED_PLOT) return;
+    manul_point_field.Set(XYcontrol->manul_victory_point);
+    auto_point_field.Set(XYcontrol->auto_victory_point);
   }
 
   // OLED显示单次兑矿成功后的用时
   void OLED_ShowSingleTime()
   {
+    if (XY_OLED_PLOT) return;
     if (over_time)
     {
-      OLED_PrintString(60, 6, "OVERTIME", &font16x16, OLED_COLOR_NORMAL);
+      time_field.SetText("OVERTIME");
     }
     else if (!exchange_success)
     {
-      OLED_PrintASCIIString(60, 6, "0          ", &afont16x8, OLED_COLOR_NORMAL);  // 打印转换后的字符串
+      time_field.Set(0);
     }
   }
 
   // 实时显示兑矿时间
   void OLED_LiveShowSingleTime()
   {
+    if (XY_OLED_PLOT) return;
     if (!reset_flag)
     {
-      sprintf(time_str, "%lu", (HAL_GetTick() - XYcontrol->exchange_start_time - move_time) / 1000);  // 将sys_tick的值转换为字符串
-      OLED_PrintASCIIString(60, 6, time_str, &afont16x8, OLED_COLOR_NORMAL);                          // 打印转换后的字符串
+      time_field.Set((ClockMicros() - XYcontrol->exchange_start_time - move_time * 1000ULL) / 1000000);
     }
   }
 
+  // 调参曲线: 每周期采样一次, 只绘制新增的列
+  void OLED_ShowPlot()
+  {
+    if (!XY_OLED_PLOT) return;
+    fp64 target = XY_OLED_PLOT == 2 ? XYcontrol->y_pos_new : XYcontrol->x_pos_new;
+    fp64 actual = XY_OLED_PLOT == 2 ? XYcontrol->y_pos : XYcontrol->x_pos;
+    position_plot.Push(static_cast<int32_t>(target * 10), static_cast<int32_t>(actual * 10));
+    position_plot.Draw();
+  }
+
   /*************************************/
 
   // 更新位置计数(x轴导程14mm, y轴导程8mm)，内径x760(-330~0~330)->(-300~0~300),y400(0~200~400)->(-100~0~100)
@@ -134,117 +185,224 @@ extern "C"
     last_y_encoder = current_y_encoder;
   }
 
-  // 复位档摇杆检测
-  void CheckResetSwitch()
+  // 退出手控: 以当前位置为原点, 之后复位档和各等级的目标都相对该位置, 不会开回手控前的原点
+  void LeaveManual()
   {
-    if (remote->switch_l() == RcSwitchState::kDown || remote->switch_r() == RcSwitchState::kDown)
-    {
-      reset_flag = true;
-    }
+    teleop->Reset();
+    XYcontrol->x_pos = 0;
+    XYcontrol->y_pos = 0;
+    XYcontrol->x_pos_new = 0;
+    XYcontrol->y_pos_new = 0;
   }
 
-  // 运动逻辑状态机(选择运动模式)
-  void SelectExchangeLevel()
+  // 处理遥控器输入事件, 更新已确认的拨杆/拨轮/摇杆状态
+  void ProcessInputEvents()
   {
-    if (remote->switch_l() == RcSwitchState::kMid && remote->switch_r() != RcSwitchState::kDown)
+    RemoteEvent event;
+    while (remote_events.Poll(&event))
     {
-      if (remote->switch_r() == RcSwitchState::kMid)
+      switch (event.type)
       {
-        if (exchange_level != LEVEL_1)
-        {
-          single_random = false;
-          exchange_level = LEVEL_1;
-        }
-        if (!single_random)
-        {
-          XYcontrol->x_pos_new = (rand() % 601) - 300;  // -300~300
-          XYcontrol->y_pos_new = -100;
-          single_random = true;
-        }
-      }
-      else if (remote->switch_r() == RcSwitchState::kUp)
-      {
-        if (exchange_level != LEVEL_2)
-        {
-          single_random = false;
-          exchange_level = LEVEL_2;
-        }
-        if (!single_random)
-        {
-          XYcontrol->x_pos_new = (rand() % 601) - 300;  // -300~300
-          XYcontrol->y_pos_new = (rand() % 201) - 100;  // -100~100
-          single_random = true;
-        }
+        case REMOTE_EVENT_SWITCH_L:
+          input.switch_l = static_cast<RcSwitchState>(event.to);
+          level_pending = true;
+          break;
+        case REMOTE_EVENT_SWITCH_R:
+          input.switch_r = static_cast<RcSwitchState>(event.to);
+          level_pending = true;
+          break;
+        case REMOTE_EVENT_DIAL:
+          input.manual = event.to && !remote_lost;
+          teleop->Reset();
+          if (!input.manual && exchange_level == LEVEL_0) LeaveManual();
+          break;
+        case REMOTE_EVENT_STICK:
+          input.stick_active = event.to;
+          break;
+        default:
+          break;
       }
     }
-    else if (remote->switch_l() == RcSwitchState::kUp && remote->switch_r() != RcSwitchState::kDown)
+
+    // 外部命令指定或释放等级同样视为一次换挡
+    if (telemetry->override_level() != input.override_level)
     {
-      if (remote->switch_r() == RcSwitchState::kMid)
-      {
-        exchange_level = LEVEL_3;
-        XYcontrol->y_pos_new = -100;
-      }
-      else if (remote->switch_r() == RcSwitchState::kUp)
-      {
-        exchange_level = LEVEL_4;
-      }
+      input.override_level = telemetry->override_level();
+      level_pending = true;
     }
-    else
+  }
+
+  // DR16帧到达(接收中断)
+  void OnRemoteFrame(const RemoteState &state) { teleop->OnFrame(state); }
+
+  // 遥控器失联检测
+  void CheckRemoteLink()
+  {
+    bool lost = remote_receiver.UpdateLink() == REMOTE_LINK_LOST;
+
+    // 进入失控保护时退出手控, 恢复后需把拨轮拨回再拨出才能重新手控
+    if (lost && !remote_lost)
     {
-      if (exchange_level != LEVEL_0)
-      {
-        exchange_level = LEVEL_0;
-        single_random = false;
+      if (input.manual && exchange_level == LEVEL_0) LeaveManual();
+      input.manual = false;
+      input.stick_active = false;
+      teleop->Reset();
+    }
+    remote_lost = lost;
+  }
+
+  // 获取拨杆状态, 外部命令指定等级时用等效拨杆挡位代替遥控器
+  void GetSwitchState(RcSwitchState *switch_l, RcSwitchState *switch_r)
+  {
+    if (!telemetry->level_override())
+    {
+      *switch_l = input.switch_l;
+      *switch_r = input.switch_r;
+      return;
+    }
+
+    switch (telemetry->override_level())
+    {
+      case LEVEL_1:
+        *switch_l = RcSwitchState::kMid;
+        *switch_r = RcSwitchState::kMid;
+        break;
+      case LEVEL_2:
+        *switch_l = RcSwitchState::kMid;
+        *switch_r = RcSwitchState::kUp;
+        break;
+      case LEVEL_3:
+        *switch_l = RcSwitchState::kUp;
+        *switch_r = RcSwitchState::kMid;
+        break;
+      case LEVEL_4:
+        *switch_l = RcSwitchState::kUp;
+        *switch_r = RcSwitchState::kUp;
+        break;
+      default:
+        *switch_l = RcSwitchState::kDown;
+        *switch_r = RcSwitchState::kDown;
+        break;
+    }
+  }
+
+  // 复位档摇杆检测
+  void CheckResetSwitch()
+  {
+    RcSwitchState switch_l, switch_r;
+    GetSwitchState(&switch_l, &switch_r);
+
+    if (switch_l == RcSwitchState::kDown || switch_r == RcSwitchState::kDown)
+    {
+      reset_flag = true;
+    }
+  }
+
+  // 拨杆挡位对应的兑换等级
+  ExchangeLevel DecodeExchangeLevel()
+  {
+    RcSwitchState switch_l, switch_r;
+    GetSwitchState(&switch_l, &switch_r);
+
+    if (switch_l == RcSwitchState::kMid && switch_r == RcSwitchState::kMid) return LEVEL_1;
+    if (switch_l == RcSwitchState::kMid && switch_r == RcSwitchState::kUp) return LEVEL_2;
+    if (switch_l == RcSwitchState::kUp && switch_r == RcSwitchState::kMid) return LEVEL_3;
+    if (switch_l == RcSwitchState::kUp && switch_r == RcSwitchState::kUp) return LEVEL_4;
+    return LEVEL_0;
+  }
+
+  // 兑矿等级正确切换
+  void UpdateExchangeState()
+  {
+    latency_probe.MarkDecoded(XYcontrol->x_motor.rpm(), XYcontrol->y_motor.rpm());
+
+    // 切换标志置1
+    level_selected = true;
+    green_light = false;
+    exchange_success = false;
+
+    reset_flag = false;
+
+    // 超时标志置0
+    over_time = false;
+    HAL_GPIO_WritePin(GPIOE, GPIO_PIN_6, GPIO_PIN_RESET);
+
+    // 记录开始时间
+    XYcontrol->exchange_start_time = ClockMicros();
+  }
+
+  // 进入新的兑换等级, 每次换挡只执行一次
+  void EnterExchangeLevel(ExchangeLevel level)
+  {
+    exchange_level = level;
+    TimingPost(TIMING_LEVEL_CHANGED, level);
+
+    switch (level)
+    {
+      case LEVEL_1:
+        XYcontrol->x_pos_new = (rand() % 601) - 300;  // -300~300
+        XYcontrol->y_pos_new = -100;
+        break;
+      case LEVEL_2:
+        XYcontrol->x_pos_new = (rand() % 601) - 300;  // -300~300
+        XYcontrol->y_pos_new = (rand() % 201) - 100;  // -100~100
+        break;
+      case LEVEL_3:
+        XYcontrol->y_pos_new = -100;
+        break;
+      case LEVEL_4:
+        break;
+      default:
         level_selected = false;
         green_light = false;
         over_time = false;
         HAL_GPIO_WritePin(GPIOE, GPIO_PIN_6, GPIO_PIN_RESET);  // 灭红灯
-      }
-
-      // 复位或手控
-      if (remote->dial() > 500)
-      {
-        /*遥控器设置中点，摇杆控制电机*/
-        rc_x_data = utils::Map(remote->left_x(), -660, 660, -10000, 10000);
-        XYcontrol->x_pid_speed.Update(rc_x_data, XYcontrol->x_motor.rpm());
-        XYcontrol->x_motor.SetCurrent(XYcontrol->x_pid_speed.value());
-
-        rc_y_data = utils::Map(remote->left_y(), -660, 660, -10000, 10000);
-        XYcontrol->y_pid_speed.Update(rc_y_data, XYcontrol->y_motor.rpm());
-        XYcontrol->y_motor.SetCurrent(XYcontrol->y_pid_speed.value());
 
-        XYcontrol->x_pos = 0;
-        XYcontrol->y_pos = 0;
-      }
-      else
-      {
         // 复位档位
         XYcontrol->x_pos_new = 0;
         XYcontrol->y_pos_new = 0;
-      }
+        return;
     }
+
+    UpdateExchangeState();
   }
 
-  // 兑矿等级正确切换
-  void UpdateExchangeState()
+  // 运动逻辑状态机(选择运动模式)
+  void SelectExchangeLevel()
   {
-    if ((exchange_level != last_exchange_level) && (exchange_level != LEVEL_0))
+    // 空闲状态下才响应换挡, 可兑换期间的换挡保留到回到空闲后处理
+    if (level_pending)
     {
-      // 切换标志置1
-      level_selected = true;
-      green_light = false;
-      exchange_success = false;
+      level_pending = false;
+      ExchangeLevel level = DecodeExchangeLevel();
+      if (level != exchange_level)
+      {
+        // 手控中换挡, 新等级的目标相对手控停下的位置
+        if (exchange_level == LEVEL_0 && input.manual) LeaveManual();
+        EnterExchangeLevel(level);
+      }
+    }
+
+    // 复位档下拨轮打开时手控
+    if (exchange_level == LEVEL_0 && input.manual)
+    {
+      /*遥控器设置中点，摇杆控制电机, 退出手控时当前位置作为原点*/
+      teleop->Update(XYcontrol->x_pos, XYcontrol->y_pos, &rc_x_data, &rc_y_data);
 
-      reset_flag = false;
+      XYcontrol->x_pid_speed.Update(rc_x_data, XYcontrol->x_motor.rpm());
+      XYcontrol->x_motor.SetCurrent(XYcontrol->x_pid_speed.value());
 
-      // 超时标志置0
-      over_time = false;
-      HAL_GPIO_WritePin(GPIOE, GPIO_PIN_6, GPIO_PIN_RESET);
+      XYcontrol->y_pid_speed.Update(rc_y_data, XYcontrol->y_motor.rpm());
+      XYcontrol->y_motor.SetCurrent(XYcontrol->y_pid_speed.value());
+    }
 
-      // 记录开始时间
-      XYcontrol->exchange_start_time = HAL_GetTick();
+    // 外部命令指定的目标位置(仅对一、二级有效)
+    fp64 target_x, target_y;
+    if (telemetry->TakeTarget(&target_x, &target_y) && (exchange_level == LEVEL_1 || exchange_level == LEVEL_2))
+    {
+      XYcontrol->x_pos_new = target_x;
+      XYcontrol->y_pos_new = target_y;
     }
-    last_exchange_level = exchange_level;  // 记录当前等级
   }
 
   /*************************************/
@@ -302,14 +460,20 @@ extern "C"
   // 微动开关触发复位
   void ButtonTrigger()
   {
-    if (button_changed)
+    uint32_t trigger_us;
+    while (TimingTakeButton(&trigger_us))
     {
-      button_changed = false;
+      // 触发时刻只有低32位, 相对本次兑换开始时刻计算; 早于绿灯亮起的是上一次兑换遗留的消息, 丢弃
+      uint32_t since_start = trigger_us - static_cast<uint32_t>(XYcontrol->exchange_start_time);
+      if (since_start > INT32_MAX || since_start < move_time * 1000) continue;
+
       level_selected = false;
       green_light = false;
       exchange_success = true;
-      CalculateVictoryPoint((HAL_GetTick() - XYcontrol->exchange_start_time - move_time) / 1000);  // 计算胜利点
+      CalculateVictoryPoint((since_start - move_time * 1000) / 1000000);  // 计算胜利点
+      TimingPost(TIMING_EXCHANGE_COMPLETE);
       exchange_state = EXCHANGE_IDLE;
+      return;
     }
   }
 
@@ -460,11 +624,12 @@ extern "C"
   // 移动时间检查
   void MoveTimeCheck()
   {
-    if ((HAL_GetTick() - XYcontrol->exchange_start_time > move_time && level_selected) || (reset_flag))
+    if ((ClockMicros() - XYcontrol->exchange_start_time > move_time * 1000ULL && level_selected) || (reset_flag))
     {
       if (!reset_flag)
       {
         green_light = true;
+        TimingPost(TIMING_EXCHANGE_READY);
       }
       exchange_state = EXCHANGE_READY;
     }
@@ -473,13 +638,15 @@ extern "C"
   // 60秒超时检查
   void OverTimeCheck()
   {
-    if (((HAL_GetTick() - XYcontrol->exchange_start_time - move_time) > 60000 && !exchange_success) || reset_flag)
+    uint64_t used_us = ClockMicros() - XYcontrol->exchange_start_time - move_time * 1000ULL;
+    if ((used_us > 60000000 && !exchange_success) || reset_flag)
     {
       if (!reset_flag)
       {
         over_time = true;
         green_light = false;
         level_selected = false;
+        TimingPost(TIMING_TIMEOUT);
         HAL_GPIO_WritePin(GPIOE, GPIO_PIN_6, GPIO_PIN_SET);  // 亮红灯
       }
       exchange_state = EXCHANGE_IDLE;
@@ -542,7 +709,7 @@ extern "C"
   // 兑矿槽运动一
   void MoveExchangeSlot_idel()
   {
-    if (!(remote->dial() > 500))  // 避免与手控复位冲突
+    if (!input.manual)  // 避免与手控复位冲突
     {
       if (!(exchange_success || over_time) || reset_flag)
       {
@@ -575,17 +742,85 @@ extern "C"
 
   /*************************************/
 
+  // 发送CAN2遥测
+  void PublishTelemetry()
+  {
+    TelemetryState state;
+
+    state.x.pos = XYcontrol->x_pos;
+    state.x.target = XYcontrol->x_pos_new;
+    state.x.rpm = XYcontrol->x_motor.rpm();
+    state.x.current = XYcontrol->x_pid_speed.value();
+    state.y.pos = XYcontrol->y_pos;
+    state.y.target = XYcontrol->y_pos_new;
+    state.y.rpm = XYcontrol->y_motor.rpm();
+    state.y.current = XYcontrol->y_pid_speed.value();
+
+    state.level = exchange_level;
+    state.flags = (exchange_state == EXCHANGE_READY ? TELEMETRY_FLAG_READY : 0) |
+                  (green_light ? TELEMETRY_FLAG_GREEN_LIGHT : 0) |
+                  (exchange_success ? TELEMETRY_FLAG_EXCHANGE_SUCCESS : 0);
+    state.faults = (over_time ? TELEMETRY_FAULT_OVER_TIME : 0) |
+                   (fabs(XYcontrol->x_pos) >= 300 ? TELEMETRY_FAULT_X_LIMIT : 0) |
+                   (fabs(XYcontrol->y_pos) >= 100 ? TELEMETRY_FAULT_Y_LIMIT : 0) |
+                   (remote_lost ? TELEMETRY_FAULT_REMOTE_LOST : 0);
+
+    uint32_t elapsed = static_cast<uint32_t>((ClockMicros() - XYcontrol->exchange_start_time) / 1000);
+    state.timer = (exchange_state == EXCHANGE_READY && elapsed > move_time) ? elapsed - move_time : 0;
+    state.manul_point = XYcontrol->manul_victory_point;
+    state.auto_point = XYcontrol->auto_victory_point;
+
+    RemoteLinkStats link;
+    remote_receiver.LinkStats(&link);
+    state.remote.link = link.link;
+    state.remote.rate = link.rate;
+    state.remote.max_gap = link.max_gap;
+    state.remote.losses = link.losses;
+    state.remote.errors = link.errors;
+
+    telemetry->Update(state);
+  }
+
+  // 外部禁止输出, 或遥控器失联且等级不由外部命令指定时, 速度环保持0
+  bool OutputHeld() { return !telemetry->armed() || (remote_lost && !telemetry->level_override()); }
+
+  // 广播三、四级匀速往复的轨迹段参数, 输出保持时广播为静止
+  void PublishTrajectory()
+  {
+    bool moving = (exchange_level == LEVEL_3 || exchange_level == LEVEL_4) && !(exchange_success || over_time) &&
+                  !OutputHeld();
+    bool x_moving = moving;
+    bool y_moving = moving && exchange_level == LEVEL_4;
+
+    // 电机转速(rpm) -> 丝杆线速度(mm/s)
+    fp32 x_speed = motor_speed_move / 60 * step * 7;
+    fp32 y_speed = motor_speed_move / 60 * step * 4;
+
+    trajectory->Update(exchange_level, x_moving ? XYcontrol->x_pos : XYcontrol->x_pos_new,
+                       y_moving ? XYcontrol->y_pos : XYcontrol->y_pos_new, XYcontrol->x_direction,
+                       XYcontrol->y_direction, x_moving, y_moving, x_speed, y_speed);
+  }
+
   /*初始化XY控制系统的函数*/
   void XYControlInit()
   {
+    // 延迟统计需在CAN1启动前注册发送完成回调
+    latency_probe.Init();
+
     // CAN1初始化
     can1.SetFilter(0, 0);
     can1.Begin();
 
-    // 遥控器初始化
-    remote_uart = new hal::Serial(huart1, 18, hal::stm32::UartMode::kNormal, hal::stm32::UartMode::kDma);
-    remote = new DR16(*remote_uart);
-    remote->Begin();
+    // CAN2遥测初始化
+    telemetry = new Telemetry(can2);
+    trajectory = new TrajectoryBroadcaster(can2, 300, 100);
+    can2.SetFilter(0, 0);
+    can2.Begin();
+
+    // 遥控器初始化, 手控目标转速在收到帧时整形
+    teleop = new Teleop(TeleopConfig(), step * 7, step * 4);
+    remote_receiver.AttachFrameCallback(OnRemoteFrame);
+    remote_receiver.Begin();
 
     // XY二维控制对象赋值
     XYcontrol = new XYControl();
@@ -610,10 +845,20 @@ void XYControlTask(void const *argument)
 
   while (1)
   {
+    display_scheduler.MarkControlStart();
+
     OLED_ShowPoint();
 
     UpdatePosition();
 
+    OLED_ShowPlot();
+
+    latency_probe.MarkFeedback(XYcontrol->x_motor.rpm(), XYcontrol->y_motor.rpm());
+
+    CheckRemoteLink();
+
+    ProcessInputEvents();
+
     CheckResetSwitch();
 
     switch (exchange_state)
@@ -621,8 +866,6 @@ void XYControlTask(void const *argument)
       case EXCHANGE_IDLE:
         SelectExchangeLevel();
 
-        UpdateExchangeState();
-
         OLED_ShowSingleTime();
 
         MoveExchangeSlot_idel();
@@ -642,8 +885,26 @@ void XYControlTask(void const *argument)
         break;
     }
 
+    if (OutputHeld())
+    {
+      power_off();
+    }
+
+    latency_probe.MarkSetpoint();
+
     M2006::SendCommand();
 
+    latency_probe.MarkQueued();
+
+    PublishTelemetry();
+
+    PublishTrajectory();
+
+    latency_probe.DumpStep(can2);
+
+    // 本周期的绘制完成, 有变化时唤醒计时线程按刷新调度发送到屏幕
+    if (OLED_Publish() == 2) TimingNotifyDisplay();
+
     osDelay(1);
   }
 }
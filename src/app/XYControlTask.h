@@ -41,7 +41,7 @@ extern "C"
     int8_t y_direction = 1;
 
     // 计时
-    uint32_t exchange_start_time = 0;
+    uint64_t exchange_start_time = 0;  // us
     // 胜利点
     u16 manul_victory_point = 0;
     u16 auto_victory_point = 0;
@@ -64,11 +64,6 @@ extern "C"
     LEVEL_4
   };
 
-  extern bool green_light;
-  extern bool over_time;
-  extern bool exchange_success;
-  extern ExchangeLevel exchange_level;
-
 #ifdef __cplusplus
 }
 #endif
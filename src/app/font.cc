@@ -5,7 +5,7 @@
  * @attention
  * 本字体库与波特律动OLED驱动配套使用
  * 英文字库已包含
- * 中文字库请使用波特律动LED取模工具生成(https://led.baud-dance.com)
+ * 中文字库由tools/fontc.py按源码中用到的字生成, 见font_zh.cc
  * 图模也使用波特律动LED取模工具生成
  */
 // clang-format off
@@ -410,37 +410,6 @@ const unsigned char ascii_24x12[][36] = {
 
 const ASCIIFont afont24x12 = {24, 12, (unsigned char *)ascii_24x12};
 
-const uint8_t zh16x16[][36] = {
-/* 波 */ {0xe6,0xb3,0xa2,0x00,0x10,0x60,0x02,0x0c,0xc0,0x00,0xf8,0x88,0x88,0x88,0xff,0x88,0x88,0xa8,0x18,0x00,0x04,0x04,0x7c,0x03,0x80,0x60,0x1f,0x80,0x43,0x2c,0x10,0x28,0x46,0x81,0x80,0x00,},
-/* 特 */ {0xe7,0x89,0xb9,0x00,0x40,0x3c,0x10,0xff,0x10,0x10,0x40,0x48,0x48,0x48,0x7f,0x48,0xc8,0x48,0x40,0x00,0x02,0x06,0x02,0xff,0x01,0x01,0x00,0x02,0x0a,0x12,0x42,0x82,0x7f,0x02,0x02,0x00,},
-/* 律 */ {0xe5,0xbe,0x8b,0x00,0x00,0x10,0x88,0xc4,0x33,0x10,0x54,0x54,0x54,0xff,0x54,0x54,0x7c,0x10,0x10,0x00,0x02,0x01,0x00,0xff,0x00,0x10,0x12,0x12,0x12,0xff,0x12,0x12,0x12,0x10,0x00,0x00,},
-/* 动 */ {0xe5,0x8a,0xa8,0x00,0x40,0x44,0xc4,0x44,0x44,0x44,0x40,0x10,0x10,0xff,0x10,0x10,0x10,0xf0,0x00,0x00,0x10,0x3c,0x13,0x10,0x14,0xb8,0x40,0x30,0x0e,0x01,0x40,0x80,0x40,0x3f,0x00,0x00,},
-/* S */ {0x53,0x00,0x00,0x00,0x60,0x90,0x08,0x08,0x08,0x08,0x10,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x20,0x21,0x21,0x21,0x12,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* P */ {0x50,0x00,0x00,0x00,0xf8,0x08,0x08,0x08,0x08,0x08,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x02,0x02,0x02,0x02,0x02,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* O */ {0x4f,0x00,0x00,0x00,0xc0,0x30,0x08,0x08,0x08,0x08,0x08,0x08,0x30,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0x07,0x18,0x20,0x20,0x20,0x20,0x20,0x20,0x18,0x07,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* I */ {0x49,0x00,0x00,0x00,0x08,0xf8,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x3f,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* N */ {0x4e,0x00,0x00,0x00,0xf8,0x20,0x40,0x80,0x00,0x00,0x00,0xf8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x00,0x00,0x00,0x01,0x02,0x04,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* T */ {0x54,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0xf8,0x08,0x08,0x08,0x08,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* V */ {0x56,0x00,0x00,0x00,0x18,0xe0,0x00,0x00,0x00,0x00,0x00,0xe0,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x0c,0x30,0x0c,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* A */ {0x41,0x00,0x00,0x00,0x00,0x00,0x80,0x60,0x18,0x60,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0x0e,0x03,0x02,0x02,0x02,0x03,0x0e,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* L */ {0x4c,0x00,0x00,0x00,0xf8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* U */ {0x55,0x00,0x00,0x00,0xf8,0x00,0x00,0x00,0x00,0x00,0x00,0xf8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x10,0x20,0x20,0x20,0x20,0x10,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,}
-};
-const Font font16x16 = {16, 16, (const uint8_t *)zh16x16, 4, &afont16x8};
-
-const uint8_t zh14x14[][32] = {
-/* I */ {0x49,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* R */ {0x52,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0x84,0x84,0x84,0xc4,0x7c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x00,0x00,0x01,0x03,0x0c,0x08,0x00,0x00,0x00,},
-/* B */ {0x42,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0x44,0x44,0x44,0xc4,0xbc,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x08,0x08,0x08,0x08,0x0f,0x07,0x00,0x00,0x00,},
-/* O */ {0x4f,0x00,0x00,0x00,0x00,0x00,0xe0,0xf8,0x0c,0x04,0x04,0x04,0x04,0x0c,0xf8,0xe0,0x00,0x00,0x00,0x00,0x01,0x07,0x0c,0x08,0x08,0x08,0x08,0x0c,0x07,0x01,0x00,0x00,},
-/* T */ {0x54,0x00,0x00,0x00,0x00,0x00,0x00,0x04,0x04,0x04,0xfc,0xfc,0x04,0x04,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* T */ {0x54,0x00,0x00,0x00,0x00,0x00,0x00,0x04,0x04,0x04,0xfc,0xfc,0x04,0x04,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* I */ {0x49,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,},
-/* M */ {0x4d,0x00,0x00,0x00,0x00,0x00,0xfc,0x04,0x3c,0xe0,0x80,0x80,0xe0,0x3c,0x04,0xfc,0x00,0x00,0x00,0x00,0x0f,0x00,0x00,0x00,0x03,0x03,0x00,0x00,0x00,0x0f,0x00,0x00,},
-/* E */ {0x45,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0xfc,0x44,0x44,0x44,0x44,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x08,0x08,0x08,0x08,0x00,0x00,0x00,0x00,}
-};
-const Font font14x14 = {14, 14, (const uint8_t *)zh14x14,sizeof(zh14x14)/32, &afont16x8};
-
 const uint8_t bilibiliData[] = {
 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x86, 0x8f, 0x9f, 0xbf, 0xff, 0xfc, 0xf8, 0xf8, 0xe0, 0xe0, 0xc0, 0x80,
 0x80, 0x80, 0x80, 0x80, 0xc0, 0xe0, 0xe0, 0xf8, 0xf8, 0xfc, 0xfe, 0xbf, 0x9f, 0x8f, 0x86, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00,
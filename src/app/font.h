@@ -14,6 +14,15 @@ extern const ASCIIFont afont12x6;
 extern const ASCIIFont afont16x8;
 extern const ASCIIFont afont24x12;
 
+/**
+ * @brief 字库索引项, 见font_index.h
+ */
+typedef struct FontIndex
+{
+  uint32_t code;   // UTF-8编码按大端拼成的32位编码
+  uint16_t glyph;  // 字模在字库中的序号
+} FontIndex;
+
 /**
  * @brief 字体结构体
  * @note  字库前4字节存储utf8编码 剩余字节存储字模数据
@@ -24,8 +33,9 @@ typedef struct Font
   uint8_t h;               // 字高度
   uint8_t w;               // 字宽度
   const uint8_t *chars;    // 字库 字库前4字节存储utf8编码 剩余字节存储字模数据
-  uint8_t len;             // 字库长度 超过256则请改为uint16_t
+  uint16_t len;            // 字库长度
   const ASCIIFont *ascii;  // 缺省ASCII字体 当字库中没有对应字符且需要显示ASCII字符时使用
+  const FontIndex *index;  // 按编码升序的索引(MakeFontIndex生成), 为NULL时顺序查找
 } Font;
 
 extern const Font font16x16;
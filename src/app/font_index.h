@@ -0,0 +1,98 @@
+#ifndef __FONT_INDEX_H
+#define __FONT_INDEX_H
+
+/**
+ * @file font_index.h
+ * @brief 中文字库的编译期索引与查找
+ *
+ * @note
+ * 字库中每个字模前4字节为UTF-8编码(不足4字节补0), 把这4字节按大端拼成32位编码,
+ * 编译期对编码排序生成FontIndex表, 运行时二分查找, 查找次数为log2(字数)
+ *
+ * 用法:
+ *   constexpr uint8_t zh16x16[][36] = {...};
+ *   constexpr auto zh16x16Index = MakeFontIndex<sizeof(zh16x16) / 36>(zh16x16);
+ *   const Font font16x16 = {16, 16, (const uint8_t *)zh16x16, sizeof(zh16x16) / 36, &afont16x8, zh16x16Index.data()};
+ */
+#include <array>
+
+#include "font.h"
+
+/**
+ * @brief 把UTF-8编码按大端拼成32位编码, 不足4字节的低位补0
+ */
+constexpr uint32_t FontCode(const uint8_t *utf8, uint8_t len)
+{
+  uint32_t code = 0;
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    code = (code << 8) | (i < len ? utf8[i] : 0);
+  }
+  return code;
+}
+
+/**
+ * @brief 编译期生成字库的前Len个字模按编码升序排列的索引
+ * @note 插入排序是稳定的, 重复的字符查找时返回字库中靠前的一个, 与顺序查找一致
+ */
+template <uint16_t Len, size_t N, size_t Size>
+constexpr std::array<FontIndex, Len> MakeFontIndex(const uint8_t (&chars)[N][Size])
+{
+  static_assert(Len <= N, "font index longer than font table");
+
+  std::array<FontIndex, Len> index{};
+  for (uint16_t i = 0; i < Len; i++)
+  {
+    FontIndex entry{FontCode(chars[i], 4), i};
+    uint16_t j = i;
+    for (; j > 0 && index[j - 1].code > entry.code; j--)
+    {
+      index[j] = index[j - 1];
+    }
+    index[j] = entry;
+  }
+  return index;
+}
+
+/**
+ * @brief 在字库中查找字符的字模
+ * @param font 字体
+ * @param str 字符的UTF-8编码
+ * @param utf8Len UTF-8编码长度
+ * @return 字模头指针(前4字节为编码), 未找到返回NULL
+ * @note 字体没有索引时顺序查找
+ */
+inline const uint8_t *FontFindGlyph(const Font *font, const char *str, uint8_t utf8Len)
+{
+  uint16_t oneLen = (((font->h + 7) / 8) * font->w) + 4;  // 一个字模占多少字节
+
+  if (font->index == NULL)
+  {
+    for (uint16_t j = 0; j < font->len; j++)
+    {
+      const uint8_t *head = font->chars + (j * oneLen);
+      if (memcmp(str, head, utf8Len) == 0) return head;
+    }
+    return NULL;
+  }
+
+  // 二分查找第一个不小于code的位置
+  uint32_t code = FontCode((const uint8_t *)str, utf8Len);
+  uint16_t low = 0, high = font->len;
+  while (low < high)
+  {
+    uint16_t mid = (low + high) / 2;
+    if (font->index[mid].code < code)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  if (low == font->len || font->index[low].code != code) return NULL;
+  return font->chars + (font->index[low].glyph * oneLen);
+}
+
+#endif  // __FONT_INDEX_H
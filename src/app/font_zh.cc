@@ -0,0 +1,17 @@
+/**
+ * @file font_zh.cc
+ * @brief 中文字库(由tools/fontc.py生成, 请勿手动修改)
+ *
+ * @note
+ * 只包含源码字符串中与字体一起使用的非ASCII字符, ASCII字符由缺省ASCII字体显示.
+ * 修改中文文本后重新生成, 见src/CMakeLists.txt中的XY_FONT_BDF.
+ */
+// clang-format off
+#include "font.h"
+#include "font_index.h"
+
+// 源码中没有与font16x16一起使用的中文字符
+const Font font16x16 = {16, 16, NULL, 0, &afont16x8, NULL};
+
+// 源码中没有与font14x14一起使用的中文字符
+const Font font14x14 = {14, 14, NULL, 0, &afont16x8, NULL};
@@ -15,13 +15,33 @@
  * 1. STM32初始化IIC完成后调用OLED_Init()初始化OLED. 注意STM32启动比OLED上电快, 可等待20ms再初始化OLED
  * 2. 调用OLED_NewFrame()开始绘制新的一帧
  * 3. 调用OLED_DrawXXX()系列函数绘制图形到显存 调用OLED_Printxxx()系列函数绘制文本到显存
- * 4. 调用OLED_ShowFrame()将显存内容显示到OLED
+ * 4. 调用OLED_Publish()发布绘制完成的一帧
+ * 5. 刷新线程周期调用OLED_ShowFrame()将已发布的一帧显示到OLED,
+ *    或调用OLED_ShowPages()只发送部分页, 其余页的变化留到之后(见DisplayScheduler)
+ *
+ * @note
+ * 显存分为绘制缓冲区和发布缓冲区: 绘制函数只写绘制缓冲区, OLED_Publish()在临界区内交换两者,
+ * OLED_ShowFrame()只读发布缓冲区, 绘制线程和刷新线程互不等待, 也不会发出绘制到一半的画面
+ *
+ * @note
+ * 显存按页记录发生变化的列范围(脏区), 写入与原值相同的数据不会标记脏区,
+ * OLED_ShowFrame()只发送各页的脏区, 画面不变时不占用I2C总线
+ *
+ * @note
+ * 屏幕工作在水平(或垂直)寻址模式, 每次刷新先用21h/22h设置列/页窗口,
+ * 再把窗口内的数据作为一次连续传输发出, 地址由SSD1306自动递增
+ *
+ * @note
+ * I2C以DMA方式发送, 传输放入队列后立即返回, 完成中断中启动下一次传输;
+ * 传输出错或超时后, 下一次OLED_ShowFrame()释放总线(翻转SCL)、重新初始化I2C2和SSD1306并完整重绘,
+ * 总线异常不会阻塞调用线程
  *
  * @note
  * 为保证中文显示正常 请将编译器的字符集设置为UTF-8
  *
  */
 #include "oled.h"
+#include "font_index.h"
 #include "i2c.h"
 #include <math.h>
 #include <stdlib.h>
@@ -29,91 +49,375 @@
 // OLED器件地址
 #define OLED_ADDRESS 0x78
 
+// I2C2引脚, 总线恢复时切换为GPIO
+#define OLED_I2C_PORT GPIOF
+#define OLED_SDA_PIN GPIO_PIN_0
+#define OLED_SCL_PIN GPIO_PIN_1
+
 // OLED参数
 #define OLED_PAGE 8             // OLED页数
 #define OLED_ROW 8 * OLED_PAGE  // OLED行数
 #define OLED_COLUMN 128         // OLED列数
 
-// 显存
-uint8_t OLED_GRAM[OLED_PAGE][OLED_COLUMN];
+// 寻址模式(20h指令参数): 水平模式先列后页, 垂直模式先页后列
+#define OLED_ADDRESSING_HORIZONTAL 0x00
+#define OLED_ADDRESSING_VERTICAL 0x01
+#define OLED_ADDRESSING OLED_ADDRESSING_HORIZONTAL
+
+// 每个窗口额外的传输开销(字节): 窗口指令传输7字节 数据传输控制字节1字节 两次器件地址
+#define OLED_WINDOW_OVERHEAD 10
+
+// 显存: 绘制缓冲区(OLED_GRAM)和发布缓冲区(OLED_Front), 发布时交换
+static uint8_t OLED_Buffer[2][OLED_PAGE][OLED_COLUMN];
+static uint8_t (*volatile OLED_GRAM)[OLED_COLUMN] = OLED_Buffer[0];
+static uint8_t (*volatile OLED_Front)[OLED_COLUMN] = OLED_Buffer[1];
+static volatile uint8_t OLED_Reading = 0;  // 刷新线程正在读取发布缓冲区, 此时不交换
+
+// 脏区: 每页需要刷新的列范围[min, max], min > max表示该页没有变化
+static uint8_t OLED_DirtyMin[OLED_PAGE];  // 绘制缓冲区中尚未发布的变化
+static uint8_t OLED_DirtyMax[OLED_PAGE];
+static uint8_t OLED_FrontMin[OLED_PAGE];  // 已发布但尚未发送的变化
+static uint8_t OLED_FrontMax[OLED_PAGE];
 
 // ========================== 底层通信函数 ==========================
 
+// 传输队列: 最多每页一个窗口(指令传输+数据传输), 另留少量余量
+#define OLED_QUEUE_SIZE (OLED_PAGE * 2 + 2)
+#define OLED_CMD_MAX 32  // 队列中复制保存的最大长度, 更长的数据以指针引用
+#define OLED_TIMEOUT 50           // 单次传输超时(ms), 完整一帧约24ms
+#define OLED_RECOVER_INTERVAL 200  // 两次总线恢复的最小间隔(ms), 避免屏幕掉电时持续重试
+
+typedef struct
+{
+  const uint8_t *buffer;  // 非空时发送该缓冲区, 否则发送data
+  uint16_t len;
+  uint8_t data[OLED_CMD_MAX];  // 首字节为控制字节 0x00指令 0x40数据
+} OLED_Transfer;
+
+// 窗口数据发送缓冲区, 每个窗口前留出1字节控制字节; 仅在队列为空时写入
+static uint8_t OLED_TxBuffer[OLED_PAGE * (OLED_COLUMN + 1)];
+
+static OLED_Transfer OLED_Queue[OLED_QUEUE_SIZE];
+static volatile uint8_t OLED_QueueHead = 0;   // 下一个写入位置(线程)
+static volatile uint8_t OLED_QueueTail = 0;   // 正在发送的位置(中断)
+static volatile uint8_t OLED_Busy = 0;        // DMA传输进行中
+static volatile uint8_t OLED_Fault = 0;       // 传输出错或超时, 需要恢复总线
+static volatile uint32_t OLED_StartTime = 0;  // 当前传输开始时间
+static uint32_t OLED_RecoverTime = 0;         // 上一次总线恢复时间
+
+static OLED_Stats OLED_TransportStats = {};
+
+/**
+ * @brief 丢弃队列中剩余的传输并标记故障
+ * @note 需在关中断或中断上下文中调用
+ */
+static void OLED_Abort()
+{
+  OLED_Busy = 0;
+  OLED_QueueTail = OLED_QueueHead;
+  OLED_Fault = 1;
+}
+
+/**
+ * @brief 若空闲则启动队列中的下一次传输
+ * @note 需在关中断或中断上下文中调用
+ */
+static void OLED_StartNext()
+{
+  if (OLED_Busy || OLED_QueueTail == OLED_QueueHead) return;
+
+  OLED_Transfer *transfer = &OLED_Queue[OLED_QueueTail];
+  uint8_t *data = transfer->buffer ? (uint8_t *)transfer->buffer : transfer->data;
+  OLED_Busy = 1;
+  OLED_StartTime = HAL_GetTick();
+  if (HAL_I2C_Master_Transmit_DMA(&hi2c2, OLED_ADDRESS, data, transfer->len) != HAL_OK)
+  {
+    // 启动失败(总线忙, 如SDA被拉低)
+    OLED_Abort();
+    OLED_TransportStats.errors++;
+  }
+}
+
+/**
+ * @brief 传输超时检查, 超时后丢弃队列并标记故障
+ */
+static void OLED_CheckTimeout()
+{
+  if (!OLED_Busy || HAL_GetTick() - OLED_StartTime <= OLED_TIMEOUT) return;
+
+  __disable_irq();
+  if (OLED_Busy)
+  {
+    OLED_Abort();
+    OLED_TransportStats.timeouts++;
+  }
+  __enable_irq();
+}
+
+/**
+ * @brief 等待队列发送完毕
+ * @param timeout 最长等待时间(ms)
+ * @return 1发送完毕 0超时
+ */
+static uint8_t OLED_Flush(uint32_t timeout)
+{
+  uint32_t start = HAL_GetTick();
+  while (OLED_Busy || OLED_QueueTail != OLED_QueueHead)
+  {
+    OLED_CheckTimeout();
+    if (HAL_GetTick() - start > timeout) return 0;
+  }
+  return 1;
+}
+
 /**
  * @brief 向OLED发送数据的函数
- * @param data 要发送的数据
+ * @param data 要发送的数据, 首字节为控制字节
  * @param len 要发送的数据长度
- * @return None
+ * @return 1已加入队列 0队列已满
+ * @note 不超过OLED_CMD_MAX的数据被复制到传输队列, 更长的数据直接引用, 需保持有效直到发送完成
+ * @note 加入队列后立即返回, 由DMA在后台发送, 完成中断中启动下一次传输
  * @note 此函数是移植本驱动时的重要函数 将本驱动库移植到其他平台时应根据实际情况修改此函数
  */
-void OLED_Send(uint8_t *data, uint8_t len) { HAL_I2C_Master_Transmit(&hi2c2, OLED_ADDRESS, data, len, HAL_MAX_DELAY); }
+uint8_t OLED_Send(const uint8_t *data, uint16_t len)
+{
+  uint8_t next = (OLED_QueueHead + 1) % OLED_QUEUE_SIZE;
+  if (next == OLED_QueueTail)
+  {
+    OLED_TransportStats.dropped++;
+    return 0;
+  }
+
+  OLED_Transfer *transfer = &OLED_Queue[OLED_QueueHead];
+  if (len <= OLED_CMD_MAX)
+  {
+    memcpy(transfer->data, data, len);
+    transfer->buffer = NULL;
+  }
+  else
+  {
+    transfer->buffer = data;
+  }
+  transfer->len = len;
+
+  __disable_irq();
+  OLED_QueueHead = next;
+  OLED_StartNext();
+  __enable_irq();
+
+  OLED_TransportStats.transfers++;
+  OLED_TransportStats.bytes += len;
+  return 1;
+}
 
 /**
  * @brief 向OLED发送指令
  */
 void OLED_SendCmd(uint8_t cmd)
 {
-  static uint8_t sendBuffer[2] = {0};
-  sendBuffer[1] = cmd;
+  uint8_t sendBuffer[2] = {0x00, cmd};
   OLED_Send(sendBuffer, 2);
 }
 
-// ========================== OLED驱动函数 ==========================
-
 /**
- * @brief 初始化OLED (SSD1306)
- * @note 此函数是移植本驱动时的重要函数 将本驱动库移植到其他驱动芯片时应根据实际情况修改此函数
+ * @brief I2C发送完成回调(中断上下文)
  */
-void OLED_Init()
+extern "C" void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
 {
-  OLED_SendCmd(0xAE); /*关闭显示 display off*/
+  if (hi2c != &hi2c2 || !OLED_Busy) return;  // 超时丢弃后迟到的完成中断
+  OLED_Busy = 0;
+  OLED_QueueTail = (OLED_QueueTail + 1) % OLED_QUEUE_SIZE;
+  OLED_StartNext();
+}
 
-  OLED_SendCmd(0x20);
-  OLED_SendCmd(0x10);
+/**
+ * @brief I2C错误回调(中断上下文, 应答失败/仲裁丢失/总线错误), 丢弃剩余传输并标记故障
+ */
+extern "C" void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c != &hi2c2) return;
+  OLED_Abort();
+  OLED_TransportStats.errors++;
+}
 
-  OLED_SendCmd(0xB0);
+/**
+ * @brief 总线恢复时的半个SCL周期延时, 约5us
+ */
+static void OLED_BusDelay()
+{
+  for (volatile uint16_t i = 0; i < 200; i++)
+  {
+  }
+}
 
-  OLED_SendCmd(0xC8);
+/**
+ * @brief 释放被从机拉低的SDA
+ * @note 从机在字节中途被打断时会一直拉低SDA, 以GPIO输出最多9个SCL脉冲让其移出剩余数据位,
+ *       再产生一个STOP条件; 需在I2C外设关闭时调用
+ */
+static void OLED_BusClear()
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {};
+  GPIO_InitStruct.Pin = OLED_SCL_PIN | OLED_SDA_PIN;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  HAL_GPIO_WritePin(OLED_I2C_PORT, OLED_SCL_PIN | OLED_SDA_PIN, GPIO_PIN_SET);
+  HAL_GPIO_Init(OLED_I2C_PORT, &GPIO_InitStruct);
+  OLED_BusDelay();
 
-  OLED_SendCmd(0x00);
-  OLED_SendCmd(0x10);
+  for (uint8_t i = 0; i < 9 && HAL_GPIO_ReadPin(OLED_I2C_PORT, OLED_SDA_PIN) == GPIO_PIN_RESET; i++)
+  {
+    HAL_GPIO_WritePin(OLED_I2C_PORT, OLED_SCL_PIN, GPIO_PIN_RESET);
+    OLED_BusDelay();
+    HAL_GPIO_WritePin(OLED_I2C_PORT, OLED_SCL_PIN, GPIO_PIN_SET);
+    OLED_BusDelay();
+  }
 
-  OLED_SendCmd(0x40);
+  // STOP: SCL高电平时SDA由低变高
+  HAL_GPIO_WritePin(OLED_I2C_PORT, OLED_SDA_PIN, GPIO_PIN_RESET);
+  OLED_BusDelay();
+  HAL_GPIO_WritePin(OLED_I2C_PORT, OLED_SDA_PIN, GPIO_PIN_SET);
+  OLED_BusDelay();
+}
 
-  OLED_SendCmd(0x81);
+/**
+ * @brief 传输队列是否仍有未发送完的数据
+ * @return 1忙 0空闲(包括出错后等待恢复)
+ */
+uint8_t OLED_IsBusy() { return OLED_Busy || OLED_QueueTail != OLED_QueueHead; }
 
-  OLED_SendCmd(0xDF);
-  OLED_SendCmd(0xA1);
+/**
+ * @brief 获取传输统计
+ */
+void OLED_GetStats(OLED_Stats *stats) { *stats = OLED_TransportStats; }
 
-  OLED_SendCmd(0xA6);
-  OLED_SendCmd(0xA8);
+// ========================== 脏区管理函数 ==========================
 
-  OLED_SendCmd(0x3F);
+/**
+ * @brief 将某页的一段列标记为脏区
+ */
+static inline void OLED_MarkDirty(uint8_t page, uint8_t start, uint8_t end)
+{
+  if (start < OLED_DirtyMin[page]) OLED_DirtyMin[page] = start;
+  if (end > OLED_DirtyMax[page]) OLED_DirtyMax[page] = end;
+}
 
-  OLED_SendCmd(0xA4);
+/**
+ * @brief 将整个屏幕标记为脏区, 下一次OLED_ShowFrame()发送完整一帧
+ */
+static void OLED_MarkAllDirty()
+{
+  __disable_irq();
+  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  {
+    OLED_FrontMin[i] = 0;
+    OLED_FrontMax[i] = OLED_COLUMN - 1;
+  }
+  __enable_irq();
+}
 
-  OLED_SendCmd(0xD3);
-  OLED_SendCmd(0x00);
+/**
+ * @brief 已发布但尚未发送的页
+ * @return 页掩码, 第i位对应第i页; 传输出错待恢复时返回0xFF(恢复后需要完整重绘)
+ */
+uint8_t OLED_PendingPages()
+{
+  if (OLED_Fault) return 0xFF;
+  uint8_t pages = 0;
+  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  {
+    if (OLED_FrontMin[i] <= OLED_FrontMax[i]) pages |= 1 << i;
+  }
+  return pages;
+}
 
-  OLED_SendCmd(0xD5);
-  OLED_SendCmd(0xF0);
+/**
+ * @brief 写入显存中的一字节, 数据发生变化时标记脏区
+ */
+static inline void OLED_WriteGRAM(uint8_t page, uint8_t column, uint8_t data)
+{
+  if (OLED_GRAM[page][column] == data) return;
+  OLED_GRAM[page][column] = data;
+  OLED_MarkDirty(page, column, column);
+}
 
-  OLED_SendCmd(0xD9);
-  OLED_SendCmd(0x22);
+// ========================== OLED驱动函数 ==========================
 
-  OLED_SendCmd(0xDA);
-  OLED_SendCmd(0x12);
+// SSD1306初始化指令, 合并为一次传输
+static const uint8_t OLED_InitCmds[] = {
+    0x00,                   // 控制字节: 后续均为指令
+    0xAE,                   /*关闭显示 display off*/
+    0x20, OLED_ADDRESSING,  // 水平/垂直寻址模式, 刷新时用21h/22h设置窗口
+    0x21, 0x00, OLED_COLUMN - 1,
+    0x22, 0x00, OLED_PAGE - 1,
+    0xC8,
+    0x40,
+    0x81, 0xDF,
+    0xA1,
+    0xA6,
+    0xA8, 0x3F,
+    0xA4,
+    0xD3, 0x00,
+    0xD5, 0xF0,
+    0xD9, 0x22,
+    0xDA, 0x12,
+    0xDB, 0x20,
+    0x8D, 0x14,
+};
 
-  OLED_SendCmd(0xDB);
-  OLED_SendCmd(0x20);
+static uint8_t OLED_DisplayOn = 0;  // 显示开关, 总线恢复后按此恢复
+static uint8_t OLED_Reversed = 0;   // 反色模式, 总线恢复后按此恢复
 
-  OLED_SendCmd(0x8D);
-  OLED_SendCmd(0x14);
+/**
+ * @brief 初始化OLED (SSD1306)
+ * @note 此函数是移植本驱动时的重要函数 将本驱动库移植到其他驱动芯片时应根据实际情况修改此函数
+ */
+void OLED_Init()
+{
+  OLED_Send(OLED_InitCmds, sizeof(OLED_InitCmds));
+  OLED_Flush(OLED_TIMEOUT);
 
-  OLED_NewFrame();
+  // 上电后屏幕内部显存内容不确定, 首帧完整发送
+  memset(OLED_Buffer, 0, sizeof(OLED_Buffer));
+  memset(OLED_DirtyMin, OLED_COLUMN, sizeof(OLED_DirtyMin));
+  memset(OLED_DirtyMax, 0, sizeof(OLED_DirtyMax));
+  OLED_MarkAllDirty();
   OLED_ShowFrame();
+  OLED_Flush(OLED_TIMEOUT * OLED_QUEUE_SIZE);
 
   OLED_SendCmd(0xAF); /*开启显示 display ON*/
+  OLED_DisplayOn = 1;
+}
+
+/**
+ * @brief 传输故障后恢复总线和屏幕
+ * @note 复位I2C2并释放总线, 重新发送初始化指令和显示状态, 之后由调用者完整重绘;
+ *       只把指令放入传输队列, 不等待发送完成
+ */
+static void OLED_Recover()
+{
+  HAL_I2C_DeInit(&hi2c2);  // 停止DMA和I2C2, 引脚恢复为默认状态
+  OLED_BusClear();
+  MX_I2C2_Init();
+
+  __disable_irq();
+  OLED_Busy = 0;
+  OLED_QueueTail = OLED_QueueHead;
+  OLED_Fault = 0;
+  __enable_irq();
+
+  uint8_t stateCmds[] = {
+      0x00,
+      0x8D, (uint8_t)(OLED_DisplayOn ? 0x14 : 0x10),  // 电荷泵
+      (uint8_t)(OLED_DisplayOn ? 0xAF : 0xAE),        // 显示开关
+      (uint8_t)(OLED_Reversed ? 0xA7 : 0xA6),         // 颜色模式
+  };
+  OLED_Send(OLED_InitCmds, sizeof(OLED_InitCmds));
+  OLED_Send(stateCmds, sizeof(stateCmds));
+
+  OLED_MarkAllDirty();
+  OLED_TransportStats.recoveries++;
 }
 
 /**
@@ -124,6 +428,7 @@ void OLED_DisPlay_On()
   OLED_SendCmd(0x8D);  // 电荷泵使能
   OLED_SendCmd(0x14);  // 开启电荷泵
   OLED_SendCmd(0xAF);  // 点亮屏幕
+  OLED_DisplayOn = 1;
 }
 
 /**
@@ -134,6 +439,7 @@ void OLED_DisPlay_Off()
   OLED_SendCmd(0x8D);  // 电荷泵使能
   OLED_SendCmd(0x10);  // 关闭电荷泵
   OLED_SendCmd(0xAE);  // 关闭屏幕
+  OLED_DisplayOn = 0;
 }
 
 /**
@@ -146,10 +452,12 @@ void OLED_SetColorMode(OLED_ColorMode mode)
   if (mode == OLED_COLOR_NORMAL)
   {
     OLED_SendCmd(0xA6);  // 正常显示
+    OLED_Reversed = 0;
   }
   if (mode == OLED_COLOR_REVERSED)
   {
     OLED_SendCmd(0xA7);  // 反色显示
+    OLED_Reversed = 1;
   }
 }
 
@@ -157,25 +465,182 @@ void OLED_SetColorMode(OLED_ColorMode mode)
 
 /**
  * @brief 清空显存 绘制新的一帧
+ * @note 只有原来非空的列会被标记为脏区
+ */
+void OLED_NewFrame()
+{
+  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  {
+    for (uint8_t j = 0; j < OLED_COLUMN; j++)
+    {
+      OLED_WriteGRAM(i, j, 0);
+    }
+  }
+}
+
+/**
+ * @brief 发布绘制完成的一帧
+ * @return 2已发布本次的变化 1没有变化 0刷新线程正在读取上一帧, 本次变化保留到下一次发布
+ * @note 在临界区内交换绘制缓冲区和发布缓冲区并合并脏区, 不等待I2C传输;
+ *       交换后新的绘制缓冲区是上一次发布的画面, 把本次发布的变化复制过去即与屏幕内容一致
+ */
+uint8_t OLED_Publish()
+{
+  uint8_t min[OLED_PAGE], max[OLED_PAGE];
+  uint8_t changed = 0;
+  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  {
+    changed |= OLED_DirtyMin[i] <= OLED_DirtyMax[i];
+  }
+  if (!changed) return 1;
+
+  __disable_irq();
+  if (OLED_Reading)
+  {
+    __enable_irq();
+    return 0;
+  }
+  uint8_t(*front)[OLED_COLUMN] = OLED_GRAM;
+  OLED_GRAM = OLED_Front;
+  OLED_Front = front;
+  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  {
+    min[i] = OLED_DirtyMin[i];
+    max[i] = OLED_DirtyMax[i];
+    if (min[i] < OLED_FrontMin[i]) OLED_FrontMin[i] = min[i];
+    if (max[i] > OLED_FrontMax[i]) OLED_FrontMax[i] = max[i];
+    OLED_DirtyMin[i] = OLED_COLUMN;
+    OLED_DirtyMax[i] = 0;
+  }
+  __enable_irq();
+
+  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  {
+    if (min[i] > max[i]) continue;
+    memcpy(&OLED_GRAM[i][min[i]], &front[i][min[i]], max[i] - min[i] + 1);
+  }
+  return 2;
+}
+
+/**
+ * @brief 发送显存中的一个矩形窗口
+ * @param start 起始列
+ * @param end 结束列(含)
+ * @param pageStart 起始页
+ * @param pageEnd 结束页(含)
+ * @param buffer 在OLED_TxBuffer中的写入位置
+ * @return 下一个窗口的写入位置
+ * @note 设置列/页窗口后, 窗口内数据按寻址模式的递增顺序排列, 作为一次传输发出
  */
-void OLED_NewFrame() { memset(OLED_GRAM, 0, sizeof(OLED_GRAM)); }
+static uint8_t *OLED_SendWindow(uint8_t start, uint8_t end, uint8_t pageStart, uint8_t pageEnd, uint8_t *buffer)
+{
+  uint8_t cmd[7] = {0x00, 0x21, start, end, 0x22, pageStart, pageEnd};
+  OLED_Send(cmd, sizeof(cmd));
+
+  uint8_t *p = buffer;
+  *p++ = 0x40;
+#if OLED_ADDRESSING == OLED_ADDRESSING_VERTICAL
+  for (uint8_t j = start; j <= end; j++)
+  {
+    for (uint8_t i = pageStart; i <= pageEnd; i++)
+    {
+      *p++ = OLED_Front[i][j];
+    }
+  }
+#else
+  for (uint8_t i = pageStart; i <= pageEnd; i++)
+  {
+    memcpy(p, &OLED_Front[i][start], end - start + 1);
+    p += end - start + 1;
+  }
+#endif
+  OLED_Send(buffer, p - buffer);
+  return p;
+}
 
 /**
- * @brief 将当前显存显示到屏幕上
+ * @brief 将已发布的一帧显示到屏幕上
+ * @note 等同于OLED_ShowPages(0xFF), 发送全部页的变化
  * @note 此函数是移植本驱动时的重要函数 将本驱动库移植到其他驱动芯片时应根据实际情况修改此函数
  */
-void OLED_ShowFrame()
+void OLED_ShowFrame() { OLED_ShowPages(0xFF); }
+
+/**
+ * @brief 将已发布的一帧中指定页的变化显示到屏幕上
+ * @param mask 页掩码, 第i位对应第i页; 不在掩码中的页脏区保留, 之后的发布合并进来一起发送
+ * @note 传输出错或超时后先恢复总线并重新初始化屏幕, 再完整重绘(同样只发送掩码中的页)
+ * @note 没有变化时不进行任何传输. 脏区的外接矩形作为一个窗口一次发出;
+ *       若外接矩形比逐页发送多出的数据超过窗口开销, 则改为每页一个窗口
+ * @note 数据放入传输队列后立即返回; 上一帧尚未发送完时本次不发送, 脏区保留到下一次
+ */
+void OLED_ShowPages(uint8_t mask)
 {
-  static uint8_t sendBuffer[OLED_COLUMN + 1];
-  sendBuffer[0] = 0x40;
+  OLED_CheckTimeout();
+  if (OLED_Fault)
+  {
+    // 恢复后初始化指令先于重绘数据进入队列
+    if (HAL_GetTick() - OLED_RecoverTime < OLED_RECOVER_INTERVAL) return;
+    OLED_RecoverTime = HAL_GetTick();
+    OLED_Recover();
+  }
+  else if (OLED_Busy || OLED_QueueTail != OLED_QueueHead)
+  {
+    return;
+  }
+
+  // 取出已发布的脏区, 读取期间禁止交换缓冲区
+  uint8_t min[OLED_PAGE], max[OLED_PAGE];
+  __disable_irq();
+  OLED_Reading = 1;
+  for (uint8_t i = 0; i < OLED_PAGE; i++)
+  {
+    if (!(mask & (1 << i)))
+    {
+      min[i] = OLED_COLUMN;
+      max[i] = 0;
+      continue;
+    }
+    min[i] = OLED_FrontMin[i];
+    max[i] = OLED_FrontMax[i];
+    OLED_FrontMin[i] = OLED_COLUMN;
+    OLED_FrontMax[i] = 0;
+  }
+  __enable_irq();
+
+  // 统计脏区外接矩形和逐页发送的数据量
+  uint8_t start = OLED_COLUMN, end = 0, pageStart = OLED_PAGE, pageEnd = 0, pages = 0;
+  uint16_t spanBytes = 0;
   for (uint8_t i = 0; i < OLED_PAGE; i++)
   {
-    OLED_SendCmd(0xB0 + i);  // 设置页地址
-    OLED_SendCmd(0x00);      // 设置列地址低4位
-    OLED_SendCmd(0x10);      // 设置列地址高4位
-    memcpy(sendBuffer + 1, OLED_GRAM[i], OLED_COLUMN);
-    OLED_Send(sendBuffer, OLED_COLUMN + 1);
+    if (min[i] > max[i]) continue;
+    if (min[i] < start) start = min[i];
+    if (max[i] > end) end = max[i];
+    if (i < pageStart) pageStart = i;
+    pageEnd = i;
+    pages++;
+    spanBytes += max[i] - min[i] + 1;
+  }
+  if (pages == 0)
+  {
+    OLED_Reading = 0;
+    return;
+  }
+
+  uint16_t boxBytes = (uint16_t)(end - start + 1) * (pageEnd - pageStart + 1);
+  if (boxBytes <= spanBytes + (pages - 1) * OLED_WINDOW_OVERHEAD)
+  {
+    OLED_SendWindow(start, end, pageStart, pageEnd, OLED_TxBuffer);
+  }
+  else
+  {
+    uint8_t *buffer = OLED_TxBuffer;
+    for (uint8_t i = pageStart; i <= pageEnd; i++)
+    {
+      if (min[i] > max[i]) continue;
+      buffer = OLED_SendWindow(min[i], max[i], i, i, buffer);
+    }
   }
+  OLED_Reading = 0;
 }
 
 /**
@@ -189,11 +654,124 @@ void OLED_SetPixel(uint8_t x, uint8_t y, OLED_ColorMode color)
   if (x >= OLED_COLUMN || y >= OLED_ROW) return;
   if (!color)
   {
-    OLED_GRAM[y / 8][x] |= 1 << (y % 8);
+    OLED_WriteGRAM(y / 8, x, OLED_GRAM[y / 8][x] | (1 << (y % 8)));
   }
   else
   {
-    OLED_GRAM[y / 8][x] &= ~(1 << (y % 8));
+    OLED_WriteGRAM(y / 8, x, OLED_GRAM[y / 8][x] & ~(1 << (y % 8)));
+  }
+}
+
+/**
+ * @brief 填充一个矩形区域
+ * @param x1 起始横坐标
+ * @param y1 起始纵坐标
+ * @param x2 结束横坐标(含)
+ * @param y2 结束纵坐标(含)
+ * @param color 颜色
+ * @note 坐标可以为负或超出屏幕, 开始时一次裁剪
+ * @note 按页处理, 每页预先算好行掩码, 每列只读写一个字节, 每页只标记一次脏区
+ */
+static void OLED_FillArea(int16_t x1, int16_t y1, int16_t x2, int16_t y2, OLED_ColorMode color)
+{
+  if (x1 < 0) x1 = 0;
+  if (y1 < 0) y1 = 0;
+  if (x2 >= OLED_COLUMN) x2 = OLED_COLUMN - 1;
+  if (y2 >= OLED_ROW) y2 = OLED_ROW - 1;
+  if (x1 > x2 || y1 > y2) return;
+
+  for (uint8_t page = y1 / 8; page <= y2 / 8; page++)
+  {
+    // 本页内[y1, y2]对应的位
+    uint8_t mask = 0xFF;
+    if (page == y1 / 8) mask &= 0xFF << (y1 % 8);
+    if (page == y2 / 8) mask &= 0xFF >> (7 - y2 % 8);
+
+    uint8_t *dst = OLED_GRAM[page];
+    uint8_t changed = 0;
+    for (int16_t x = x1; x <= x2; x++)
+    {
+      uint8_t value = color ? (dst[x] & ~mask) : (dst[x] | mask);
+      changed |= dst[x] != value;
+      dst[x] = value;
+    }
+    if (changed) OLED_MarkDirty(page, x1, x2);
+  }
+}
+
+/**
+ * @brief 绘制一条水平线
+ * @param x 起始横坐标
+ * @param y 纵坐标
+ * @param w 长度
+ * @param color 颜色
+ */
+void OLED_DrawHLine(uint8_t x, uint8_t y, uint8_t w, OLED_ColorMode color)
+{
+  if (w == 0) return;
+  OLED_FillArea(x, y, x + w - 1, y, color);
+}
+
+/**
+ * @brief 绘制一条竖直线
+ * @param x 横坐标
+ * @param y 起始纵坐标
+ * @param h 长度
+ * @param color 颜色
+ * @note 每页只写一个字节
+ */
+void OLED_DrawVLine(uint8_t x, uint8_t y, uint8_t h, OLED_ColorMode color)
+{
+  if (h == 0) return;
+  OLED_FillArea(x, y, x, y + h - 1, color);
+}
+
+/**
+ * @brief 区域内容左移n列, 右侧空出的n列清空
+ * @param x 区域左上角横坐标
+ * @param y 区域左上角纵坐标
+ * @param w 区域宽度
+ * @param h 区域高度
+ * @param n 左移列数
+ * @note 用于曲线等滚动显示, 只在页内搬移字节, 不重新光栅化; 整页时直接memmove
+ */
+void OLED_ScrollLeft(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t n)
+{
+  if (x >= OLED_COLUMN || y >= OLED_ROW || w == 0 || h == 0 || n == 0) return;
+  if (x + w > OLED_COLUMN) w = OLED_COLUMN - x;
+  if (y + h > OLED_ROW) h = OLED_ROW - y;
+  if (n >= w)
+  {
+    OLED_FillArea(x, y, x + w - 1, y + h - 1, OLED_COLOR_REVERSED);
+    return;
+  }
+
+  uint8_t y2 = y + h - 1;
+  uint8_t keep = w - n;  // 搬移的列数
+  for (uint8_t page = y / 8; page <= y2 / 8; page++)
+  {
+    uint8_t mask = 0xFF;
+    if (page == y / 8) mask &= 0xFF << (y % 8);
+    if (page == y2 / 8) mask &= 0xFF >> (7 - y2 % 8);
+
+    uint8_t *dst = OLED_GRAM[page] + x;
+    if (mask == 0xFF)
+    {
+      memmove(dst, dst + n, keep);
+      memset(dst + keep, 0, n);
+    }
+    else
+    {
+      for (uint8_t i = 0; i < keep; i++)
+      {
+        dst[i] = (dst[i] & ~mask) | (dst[i + n] & mask);
+      }
+      for (uint8_t i = keep; i < w; i++)
+      {
+        dst[i] &= ~mask;
+      }
+    }
+    OLED_MarkDirty(page, x, x + w - 1);
   }
 }
 
@@ -211,14 +789,13 @@ void OLED_SetPixel(uint8_t x, uint8_t y, OLED_ColorMode color)
  */
 void OLED_SetByte_Fine(uint8_t page, uint8_t column, uint8_t data, uint8_t start, uint8_t end, OLED_ColorMode color)
 {
-  static uint8_t temp;
   if (page >= OLED_PAGE || column >= OLED_COLUMN) return;
   if (color) data = ~data;
 
-  temp = data | (0xff << (end + 1)) | (0xff >> (8 - start));
-  OLED_GRAM[page][column] &= temp;
+  uint8_t temp = data | (0xff << (end + 1)) | (0xff >> (8 - start));
+  uint8_t value = OLED_GRAM[page][column] & temp;
   temp = data & ~(0xff << (end + 1)) & ~(0xff >> (8 - start));
-  OLED_GRAM[page][column] |= temp;
+  OLED_WriteGRAM(page, column, value | temp);
   // 使用OLED_SetPixel实现
   // for (uint8_t i = start; i <= end; i++) {
   //   OLED_SetPixel(column, page * 8 + i, !((data >> i) & 0x01));
@@ -237,7 +814,7 @@ void OLED_SetByte(uint8_t page, uint8_t column, uint8_t data, OLED_ColorMode col
 {
   if (page >= OLED_PAGE || column >= OLED_COLUMN) return;
   if (color) data = ~data;
-  OLED_GRAM[page][column] = data;
+  OLED_WriteGRAM(page, column, data);
 }
 
 /**
@@ -300,35 +877,87 @@ void OLED_SetBits(uint8_t x, uint8_t y, uint8_t data, OLED_ColorMode color)
  * @param color 颜色
  * @note 此函数将显存中从(x,y)开始的w*h个像素设置为data中的数据
  * @note data的数据应该采用列行式排列
+ * @note 超出屏幕的部分在开始时一次裁剪; 反色通过异或实现
+ * @note y按页对齐时源字节直接写入显存; 不对齐时每列把最多3个源字节(24行)拼成32位整体移位,
+ *       再按掩码写入4个显存字节, 字高不超过24的字体每列只需一次移位
  */
 void OLED_SetBlock(uint8_t x, uint8_t y, const uint8_t *data, uint8_t w, uint8_t h, OLED_ColorMode color)
 {
+  if (x >= OLED_COLUMN || y >= OLED_ROW || w == 0 || h == 0) return;
+
+  uint8_t cols = (x + w > OLED_COLUMN) ? OLED_COLUMN - x : w;  // 裁剪后的列数
+  uint8_t invert = color ? 0xFF : 0x00;                        // 反色异或掩码
+  uint8_t page = y / 8;
+  uint8_t bit = y % 8;
   uint8_t fullRow = h / 8;  // 完整的行数
   uint8_t partBit = h % 8;  // 不完整的字节中的有效位数
-  for (uint8_t i = 0; i < w; i++)
+
+  if (bit == 0)
   {
-    for (uint8_t j = 0; j < fullRow; j++)
+    // 对齐: 完整的源字节直接写入显存
+    for (uint8_t j = 0; j < fullRow && page + j < OLED_PAGE; j++)
     {
-      OLED_SetBits(x + i, y + j * 8, data[i + j * w], color);
+      const uint8_t *src = data + j * w;
+      uint8_t *dst = &OLED_GRAM[page + j][x];
+      uint8_t changed = 0;
+      for (uint8_t i = 0; i < cols; i++)
+      {
+        uint8_t value = src[i] ^ invert;
+        changed |= dst[i] != value;
+        dst[i] = value;
+      }
+      if (changed) OLED_MarkDirty(page + j, x, x + cols - 1);
     }
+    if (partBit && page + fullRow < OLED_PAGE)
+    {
+      const uint8_t *src = data + fullRow * w;
+      uint8_t *dst = &OLED_GRAM[page + fullRow][x];
+      uint8_t mask = 0xFF >> (8 - partBit);
+      uint8_t changed = 0;
+      for (uint8_t i = 0; i < cols; i++)
+      {
+        uint8_t value = (dst[i] & ~mask) | ((src[i] ^ invert) & mask);
+        changed |= dst[i] != value;
+        dst[i] = value;
+      }
+      if (changed) OLED_MarkDirty(page + fullRow, x, x + cols - 1);
+    }
+    return;
   }
-  if (partBit)
+
+  // 不对齐: 源数据每3字节(24行)一组, 每组写入4个显存字节, 相邻组共用的显存字节由掩码区分
+  uint8_t rows = fullRow + (partBit ? 1 : 0);
+  for (uint8_t j = 0; j < rows && page + j < OLED_PAGE; j += 3)
   {
-    uint16_t fullNum = w * fullRow;  // 完整的字节数
-    for (uint8_t i = 0; i < w; i++)
+    uint8_t n = (rows - j < 3) ? rows - j : 3;          // 本组源字节数
+    uint8_t valid = (h - j * 8 < 24) ? h - j * 8 : 24;  // 本组有效行数
+    uint32_t mask = ((1UL << valid) - 1) << bit;        // 本组在显存中占用的位
+    uint8_t last = n;                                   // 本组写入的最后一个显存字节
+    if (page + j + n >= OLED_PAGE) last = OLED_PAGE - 1 - page - j;
+    const uint8_t *src = data + j * w;
+    uint8_t changed = 0;  // 每位对应本组的一个显存页
+    for (uint8_t i = 0; i < cols; i++)
     {
-      OLED_SetBits_Fine(x + i, y + (fullRow * 8), data[fullNum + i], partBit, color);
+      uint32_t bits = src[i];
+      if (n > 1) bits |= (uint32_t)src[i + w] << 8;
+      if (n > 2) bits |= (uint32_t)src[i + 2 * w] << 16;
+      bits = (bits ^ (invert * 0x010101UL)) << bit;
+
+      for (uint8_t k = 0; k <= last; k++)
+      {
+        uint8_t m = mask >> (8 * k);
+        uint8_t *dst = &OLED_GRAM[page + j + k][x + i];
+        uint8_t value = (*dst & ~m) | ((bits >> (8 * k)) & m);
+        if (*dst != value) changed |= 1 << k;
+        *dst = value;
+      }
+    }
+    // 按页标记脏区, 整块的列范围作为脏区
+    for (uint8_t k = 0; k <= last; k++)
+    {
+      if (changed & (1 << k)) OLED_MarkDirty(page + j + k, x, x + cols - 1);
     }
   }
-  // 使用OLED_SetPixel实现
-  // for (uint8_t i = 0; i < w; i++) {
-  //   for (uint8_t j = 0; j < h; j++) {
-  //     for (uint8_t k = 0; k < 8; k++) {
-  //       if (j * 8 + k >= h) break; // 防止越界(不完整的字节
-  //       OLED_SetPixel(x + i, y + j * 8 + k, !((data[i + j * w] >> k) & 0x01));
-  //     }
-  //   }
-  // }
 }
 
 // ========================== 图形绘制函数 ==========================
@@ -343,32 +972,10 @@ void OLED_SetBlock(uint8_t x, uint8_t y, const uint8_t *data, uint8_t w, uint8_t
  */
 void OLED_DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, OLED_ColorMode color)
 {
-  static uint8_t temp = 0;
-  if (x1 == x2)
-  {
-    if (y1 > y2)
-    {
-      temp = y1;
-      y1 = y2;
-      y2 = temp;
-    }
-    for (uint8_t y = y1; y <= y2; y++)
-    {
-      OLED_SetPixel(x1, y, color);
-    }
-  }
-  else if (y1 == y2)
+  if (x1 == x2 || y1 == y2)
   {
-    if (x1 > x2)
-    {
-      temp = x1;
-      x1 = x2;
-      x2 = temp;
-    }
-    for (uint8_t x = x1; x <= x2; x++)
-    {
-      OLED_SetPixel(x, y1, color);
-    }
+    // 水平线和竖直线按区域填充
+    OLED_FillArea(x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2, x1 > x2 ? x1 : x2, y1 > y2 ? y1 : y2, color);
   }
   else
   {
@@ -419,10 +1026,10 @@ void OLED_DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, OLED_ColorMod
  */
 void OLED_DrawRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, OLED_ColorMode color)
 {
-  OLED_DrawLine(x, y, x + w, y, color);
-  OLED_DrawLine(x, y + h, x + w, y + h, color);
-  OLED_DrawLine(x, y, x, y + h, color);
-  OLED_DrawLine(x + w, y, x + w, y + h, color);
+  OLED_FillArea(x, y, x + w, y, color);
+  OLED_FillArea(x, y + h, x + w, y + h, color);
+  OLED_FillArea(x, y, x, y + h, color);
+  OLED_FillArea(x + w, y, x + w, y + h, color);
 }
 
 /**
@@ -435,10 +1042,7 @@ void OLED_DrawRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, OLED_ColorMo
  */
 void OLED_DrawFilledRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, OLED_ColorMode color)
 {
-  for (uint8_t i = 0; i < h; i++)
-  {
-    OLED_DrawLine(x, y + i, x + w, y + i, color);
-  }
+  OLED_FillArea(x, y, x + w, y + h - 1, color);
 }
 
 /**
@@ -470,33 +1074,53 @@ void OLED_DrawTriangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t x
  */
 void OLED_DrawFilledTriangle(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t x3, uint8_t y3, OLED_ColorMode color)
 {
-  uint8_t a = 0, b = 0, y = 0, last = 0;
-  if (y1 > y2)
+  // 按横坐标排序, 逐列填充竖直区间
+  int16_t px[3] = {x1, x2, x3}, py[3] = {y1, y2, y3};
+  for (uint8_t i = 0; i < 2; i++)
   {
-    a = y2;
-    b = y1;
+    for (uint8_t j = 0; j < 2 - i; j++)
+    {
+      if (px[j] > px[j + 1])
+      {
+        int16_t t = px[j];
+        px[j] = px[j + 1];
+        px[j + 1] = t;
+        t = py[j];
+        py[j] = py[j + 1];
+        py[j + 1] = t;
+      }
+    }
   }
-  else
+
+  if (px[0] == px[2])
   {
-    a = y1;
-    b = y2;
+    // 三点共竖线
+    int16_t top = py[0] < py[1] ? py[0] : py[1], bottom = py[0] > py[1] ? py[0] : py[1];
+    if (py[2] < top) top = py[2];
+    if (py[2] > bottom) bottom = py[2];
+    OLED_FillArea(px[0], top, px[0], bottom, color);
+    return;
   }
-  y = a;
-  for (; y <= b; y++)
+
+  for (int16_t x = px[0]; x <= px[2]; x++)
   {
-    if (y <= y3)
+    // 长边p0-p2, 短边p0-p1或p1-p2
+    int16_t ya = py[0] + (int32_t)(py[2] - py[0]) * (x - px[0]) / (px[2] - px[0]);
+    int16_t yb;
+    if (x < px[1])
+    {
+      yb = py[0] + (int32_t)(py[1] - py[0]) * (x - px[0]) / (px[1] - px[0]);
+    }
+    else if (px[2] == px[1])
     {
-      OLED_DrawLine(x1 + (y - y1) * (x2 - x1) / (y2 - y1), y, x1 + (y - y1) * (x3 - x1) / (y3 - y1), y, color);
+      yb = py[1];
+      if (x == px[2]) OLED_FillArea(x, py[1] < py[2] ? py[1] : py[2], x, py[1] > py[2] ? py[1] : py[2], color);
     }
     else
     {
-      last = y - 1;
-      break;
+      yb = py[1] + (int32_t)(py[2] - py[1]) * (x - px[1]) / (px[2] - px[1]);
     }
-  }
-  for (; y <= b; y++)
-  {
-    OLED_DrawLine(x2 + (y - y2) * (x3 - x2) / (y3 - y2), y, x1 + (y - last) * (x3 - x1) / (y3 - last), y, color);
+    OLED_FillArea(x, ya < yb ? ya : yb, x, ya > yb ? ya : yb, color);
   }
 }
 
@@ -549,16 +1173,11 @@ void OLED_DrawFilledCircle(uint8_t x, uint8_t y, uint8_t r, OLED_ColorMode color
   int16_t a = 0, b = r, di = 3 - (r << 1);
   while (a <= b)
   {
-    for (int16_t i = x - b; i <= x + b; i++)
-    {
-      OLED_SetPixel(i, y + a, color);
-      OLED_SetPixel(i, y - a, color);
-    }
-    for (int16_t i = x - a; i <= x + a; i++)
-    {
-      OLED_SetPixel(i, y + b, color);
-      OLED_SetPixel(i, y - b, color);
-    }
+    // 每个八分点对应的4列竖直区间
+    OLED_FillArea(x + a, y - b, x + a, y + b, color);
+    OLED_FillArea(x - a, y - b, x - a, y + b, color);
+    OLED_FillArea(x + b, y - a, x + b, y + a, color);
+    OLED_FillArea(x - b, y - a, x - b, y + a, color);
     a++;
     if (di < 0)
     {
@@ -710,52 +1329,40 @@ uint8_t _OLED_GetUTF8Len(char *string)
  *
  * @note 为保证字符串中的中文会被自动识别并绘制, 需:
  * 1. 编译器字符集设置为UTF-8
- * 2. 使用波特律动LED取模工具生成字模(https://led.baud-dance.com)
+ * 2. 字库中包含该字, 中文字库由tools/fontc.py按源码中的字符串生成(见font_zh.cc)
  */
 void OLED_PrintString(uint8_t x, uint8_t y, char *str, const Font *font, OLED_ColorMode color)
 {
-  uint16_t i = 0;                                        // 字符串索引
-  uint8_t oneLen = (((font->h + 7) / 8) * font->w) + 4;  // 一个字模占多少字节
-  uint8_t found;                                         // 是否找到字模
-  uint8_t utf8Len;                                       // UTF-8编码长度
-  uint8_t *head;                                         // 字模头指针
+  uint16_t i = 0;       // 字符串索引
+  uint8_t utf8Len;      // UTF-8编码长度
+  const uint8_t *head;  // 字模头指针
   while (str[i])
   {
-    found = 0;
     utf8Len = _OLED_GetUTF8Len(str + i);
     if (utf8Len == 0) break;  // 有问题的UTF-8编码
 
-    // 寻找字符  TODO 优化查找算法, 二分查找或者hash
-    for (uint8_t j = 0; j < font->len; j++)
+    // 在字库索引中二分查找字符
+    head = FontFindGlyph(font, str + i, utf8Len);
+    if (head != NULL)
     {
-      head = (uint8_t *)(font->chars) + (j * oneLen);
-      if (memcmp(str + i, head, utf8Len) == 0)
-      {
-        OLED_SetBlock(x, y, head + 4, font->w, font->h, color);
-        // 移动光标
-        x += font->w;
-        i += utf8Len;
-        found = 1;
-        break;
-      }
+      OLED_SetBlock(x, y, head + 4, font->w, font->h, color);
+      // 移动光标
+      x += font->w;
+      i += utf8Len;
     }
-
     // 若未找到字模,且为ASCII字符, 则缺省显示ASCII字符
-    if (found == 0)
+    else if (utf8Len == 1)
     {
-      if (utf8Len == 1)
-      {
-        OLED_PrintASCIIChar(x, y, str[i], font->ascii, color);
-        // 移动光标
-        x += font->ascii->w;
-        i += utf8Len;
-      }
-      else
-      {
-        OLED_PrintASCIIChar(x, y, ' ', font->ascii, color);
-        x += font->ascii->w;
-        i += utf8Len;
-      }
+      OLED_PrintASCIIChar(x, y, str[i], font->ascii, color);
+      // 移动光标
+      x += font->ascii->w;
+      i += utf8Len;
+    }
+    else
+    {
+      OLED_PrintASCIIChar(x, y, ' ', font->ascii, color);
+      x += font->ascii->w;
+      i += utf8Len;
     }
   }
 }
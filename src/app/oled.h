@@ -11,6 +11,17 @@ typedef enum
   OLED_COLOR_REVERSED     // 反色模式 白底黑字
 } OLED_ColorMode;
 
+// I2C传输统计
+typedef struct
+{
+  uint32_t transfers;   // 已加入队列的传输次数
+  uint32_t bytes;       // 已加入队列的字节数
+  uint32_t dropped;     // 队列满而丢弃的传输次数
+  uint32_t errors;      // I2C错误次数
+  uint32_t timeouts;    // 传输超时次数
+  uint32_t recoveries;  // 总线恢复次数
+} OLED_Stats;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -19,11 +30,19 @@ extern "C"
   void OLED_Init();
   void OLED_DisPlay_On();
   void OLED_DisPlay_Off();
+  void OLED_GetStats(OLED_Stats *stats);
+  uint8_t OLED_IsBusy();
 
   void OLED_NewFrame();
+  uint8_t OLED_Publish();
   void OLED_ShowFrame();
+  void OLED_ShowPages(uint8_t mask);
+  uint8_t OLED_PendingPages();
   void OLED_SetPixel(uint8_t x, uint8_t y, OLED_ColorMode color);
 
+  void OLED_DrawHLine(uint8_t x, uint8_t y, uint8_t w, OLED_ColorMode color);
+  void OLED_DrawVLine(uint8_t x, uint8_t y, uint8_t h, OLED_ColorMode color);
+  void OLED_ScrollLeft(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t n);
   void OLED_DrawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, OLED_ColorMode color);
   void OLED_DrawRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, OLED_ColorMode color);
   void OLED_DrawFilledRectangle(uint8_t x, uint8_t y, uint8_t w, uint8_t h, OLED_ColorMode color);
@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""
+中文字库生成器: 从BDF点阵字体生成font.h格式的Font字库, 只包含源码中用到的字
+
+用法:
+  fontc.py -o src/app/font_zh.cc \\
+      --font font16x16,16,16,afont16x8,wqy-16.bdf \\
+      --font font14x14,14,14,afont16x8,wqy-14.bdf \\
+      src/app/*.cc src/app/*.h
+
+--font为 字体名,字高,字宽,缺省ASCII字体[,BDF文件], 可重复.
+扫描源码中的字符串字面量: 一条语句(到';'为止)中引用了某个字体名, 该语句字符串中的
+非ASCII字符就收入该字体; ASCII字符由缺省ASCII字体显示, 不收入字库.
+原先手工粘贴的zh16x16末尾虽有S/P/O/I/N/T/V/A/L/U的16点阵字模, 但字数写死为4, 查找只覆盖前4个汉字,
+"TIME:"等标签一直由afont16x8显示; 不收入ASCII字符与原来的显示一致, 收入反而会改变标签的字宽和布局.
+字模与波特律动取模工具的格式一致: 前4字节为UTF-8编码(补0), 之后按页(8行)逐列存放, 低位在上,
+可直接由OLED_SetBlock绘制; 字库按编码排序, 由MakeFontIndex在编译期生成索引.
+字体没有用到任何字符时生成空字库, 此时可以不提供BDF文件.
+
+只依赖Python标准库.
+"""
+import argparse
+import os
+import re
+import sys
+
+
+class FontSpec:
+    def __init__(self, text):
+        fields = text.split(",")
+        if len(fields) not in (4, 5):
+            raise argparse.ArgumentTypeError("expected NAME,H,W,ASCII[,BDF]: " + text)
+        self.name = fields[0]
+        self.h = int(fields[1])
+        self.w = int(fields[2])
+        self.ascii = fields[3]
+        self.bdf = fields[4] if len(fields) == 5 and fields[4] else None
+        self.table = "zh%dx%d" % (self.h, self.w)
+        self.chars = set()
+
+    @property
+    def glyph_size(self):
+        return 4 + (self.h + 7) // 8 * self.w
+
+
+def split_statements(text):
+    """去掉注释, 按';'切分语句, 返回[(标识符集合, 字符串列表)]"""
+    statements = []
+    idents, strings = set(), []
+    i, n = 0, len(text)
+    while i < n:
+        c = text[i]
+        if text.startswith("//", i):
+            i = text.find("\n", i)
+            i = n if i < 0 else i
+        elif text.startswith("/*", i):
+            i = text.find("*/", i + 2)
+            i = n if i < 0 else i + 2
+        elif c == '"' or c == "'":
+            j = i + 1
+            value = []
+            while j < n and text[j] != c:
+                if text[j] == "\\":
+                    j += 1
+                value.append(text[j])
+                j += 1
+            if c == '"':
+                strings.append("".join(value))
+            i = j + 1
+        elif c.isalpha() or c == "_":
+            m = re.match(r"[A-Za-z_]\w*", text[i:])
+            idents.add(m.group(0))
+            i += len(m.group(0))
+        elif c == ";":
+            statements.append((idents, strings))
+            idents, strings = set(), []
+            i += 1
+        else:
+            i += 1
+    statements.append((idents, strings))
+    return statements
+
+
+def collect_chars(fonts, sources):
+    for path in sources:
+        with open(path, encoding="utf-8") as f:
+            text = f.read()
+        for idents, strings in split_statements(text):
+            for font in fonts:
+                if font.name in idents:
+                    for s in strings:
+                        font.chars.update(ch for ch in s if ord(ch) > 0x7E)
+
+
+def read_bdf(path):
+    """读取BDF字体, 返回(ascent, {码点: ((w, h, xoff, yoff), [(行位图, 位数)])})"""
+    glyphs = {}
+    ascent = None
+    bbox = None
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == "FONTBOUNDINGBOX":
+            bbox = [int(v) for v in words[1:5]]
+        elif words[0] == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif words[0] == "STARTCHAR":
+            code, box, rows = None, None, []
+            for line in lines:
+                words = line.split()
+                if words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words[0] == "BBX":
+                    box = [int(v) for v in words[1:5]]
+                elif words[0] == "BITMAP":
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        bits = line.strip()
+                        rows.append((int(bits, 16), len(bits) * 4))
+                    break
+            if code is not None and code >= 0:
+                glyphs[code] = (box or bbox, rows)
+    if ascent is None:
+        ascent = bbox[1] + bbox[3]
+    return ascent, glyphs
+
+
+def render(font, ascent, glyph):
+    """把BDF字形放到h*w的字格中(基线在ascent行), 返回按页逐列的字模字节"""
+    (gw, gh, xoff, yoff), rows = glyph
+    pixels = [[0] * font.w for _ in range(font.h)]
+    top = ascent - (yoff + gh)
+    clipped = False
+    for r, (bits, width) in enumerate(rows[:gh]):
+        y = top + r
+        for c in range(gw):
+            if not bits >> (width - 1 - c) & 1:
+                continue
+            x = xoff + c
+            if 0 <= x < font.w and 0 <= y < font.h:
+                pixels[y][x] = 1
+            else:
+                clipped = True
+    data = []
+    for page in range((font.h + 7) // 8):
+        for x in range(font.w):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < font.h and pixels[y][x]:
+                    byte |= 1 << bit
+            data.append(byte)
+    return data, clipped
+
+
+def generate(fonts, out):
+    lines = [
+        "/**",
+        " * @file %s" % os.path.basename(out),
+        " * @brief 中文字库(由tools/fontc.py生成, 请勿手动修改)",
+        " *",
+        " * @note",
+        " * 只包含源码字符串中与字体一起使用的非ASCII字符, ASCII字符由缺省ASCII字体显示.",
+        " * 修改中文文本后重新生成, 见src/CMakeLists.txt中的XY_FONT_BDF.",
+        " */",
+        "// clang-format off",
+        '#include "font.h"',
+        '#include "font_index.h"',
+        "",
+    ]
+    ok = True
+    for font in fonts:
+        chars = sorted(font.chars, key=lambda ch: ch.encode("utf-8").ljust(4, b"\0"))
+        if not chars:
+            lines.append("// 源码中没有与%s一起使用的中文字符" % font.name)
+            lines.append("const Font %s = {%d, %d, NULL, 0, &%s, NULL};" % (font.name, font.h, font.w, font.ascii))
+            lines.append("")
+            continue
+        if not font.bdf:
+            sys.stderr.write("%s: %d characters used but no BDF given\n" % (font.name, len(chars)))
+            ok = False
+            continue
+
+        ascent, glyphs = read_bdf(font.bdf)
+        missing = [ch for ch in chars if ord(ch) not in glyphs]
+        for ch in missing:
+            sys.stderr.write("%s: '%s' (U+%04X) not in %s\n" % (font.name, ch, ord(ch), font.bdf))
+        if missing:
+            ok = False
+            continue
+
+        lines.append("// 点阵: %s" % os.path.basename(font.bdf))
+        lines.append("constexpr uint8_t %s[][%d] = {" % (font.table, font.glyph_size))
+        for ch in chars:
+            data, clipped = render(font, ascent, glyphs[ord(ch)])
+            if clipped:
+                sys.stderr.write("%s: '%s' clipped to %dx%d\n" % (font.name, ch, font.h, font.w))
+            code = list(ch.encode("utf-8").ljust(4, b"\0"))
+            lines.append("/* %s */ {%s}," % (ch, ",".join("0x%02x" % b for b in code + data)))
+        lines.append("};")
+        count = "sizeof(%s) / %d" % (font.table, font.glyph_size)
+        lines.append("constexpr auto %sIndex = MakeFontIndex<%s>(%s);" % (font.table, count, font.table))
+        lines.append("const Font %s = {%d, %d, (const uint8_t *)%s, %s, &%s, %sIndex.data()};"
+                     % (font.name, font.h, font.w, font.table, count, font.ascii, font.table))
+        lines.append("")
+
+    # 出错时不写输出, 以免留下看似最新的半成品使构建跳过重新生成
+    if not ok:
+        return False
+    with open(out, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines))
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="generate subsetted OLED fonts from BDF")
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("--font", action="append", type=FontSpec, required=True)
+    parser.add_argument("sources", nargs="+")
+    args = parser.parse_args()
+
+    out = os.path.abspath(args.output)
+    sources = [s for s in args.sources if os.path.abspath(s) != out]
+    collect_chars(args.font, sources)
+    return 0 if generate(args.font, args.output) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())